@@ -9,13 +9,21 @@
 #define RiscvEmulator_H_
 
 #include <stdint.h>
+#include <string.h>
 
 #include "RiscvEmulatorConfig.h"
 
-#include <RiscvEmulatorImplementationSpecific.h>
+#include "RiscvEmulatorOps.h"
 
+#include "RiscvEmulatorBudget.h"
+#include "RiscvEmulatorCache.h"
 #include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorEvent.h"
 #include "RiscvEmulatorExtension.h"
+#include "RiscvEmulatorInterrupt.h"
+#include "RiscvEmulatorPredictor.h"
+#include "RiscvEmulatorProfile.h"
+#include "RiscvEmulatorTrace.h"
 #include "RiscvEmulatorTrap.h"
 #include "RiscvEmulatorType.h"
 
@@ -42,6 +50,86 @@ static inline void RiscvEmulatorInit(RiscvEmulatorState_t *state, uint32_t ram_l
 
     // Initialize trap flags.
     state->trapflag.value = 0;
+
+#if (RVE_E_RUN == 1)
+    // Initialize run state.
+    state->exitreason = EXIT_REASON_NONE;
+    state->budget = 0;
+    state->chunk = 0;
+    state->retired = 0;
+#endif
+
+#if (RVE_E_HOOK == 1)
+    state->hookmask = HOOK_MASK_ALL;
+#endif
+
+#if (RVE_E_ZICNTR == 1)
+    state->mcycleoffset = 0;
+    state->minstretoffset = 0;
+#endif
+
+#if (RVE_E_ZIHPM == 1)
+    memset(state->eventcount, 0, sizeof(state->eventcount));
+    memset(state->mhpmevent, 0, sizeof(state->mhpmevent));
+    memset(state->mhpmoffset, 0, sizeof(state->mhpmoffset));
+#endif
+
+#if (RVE_E_HISTOGRAM == 1)
+    memset(state->histogram, 0, sizeof(state->histogram));
+#endif
+
+#if (RVE_E_INTERRUPT == 1)
+    state->attention = 0;
+    state->waiting = 0;
+#endif
+
+#if (RVE_E_IDLE == 1)
+    state->idlebranch = 0;
+    state->idlecount = 0;
+    state->idlesideeffect = 1;
+#endif
+
+#if (RVE_E_TRACE == 1)
+    state->trace = 0;
+    state->tracerecord.memoryaccess = TRACE_MEMORY_NONE;
+#endif
+
+#if (RVE_E_PROFILE == 1)
+    state->profile = 0;
+#endif
+
+#if (RVE_E_HEATMAP == 1)
+    state->heatmap = 0;
+#endif
+
+#if (RVE_E_CACHE == 1)
+    state->icache = 0;
+    state->dcache = 0;
+#endif
+
+#if (RVE_E_PREDICTOR == 1)
+    state->predictor = 0;
+#endif
+
+#if (RVE_E_CLINT == 1)
+    // No timer interrupt until the timer is set.
+    state->mtimecmp = UINT64_MAX;
+    state->mtimeoffset = 0;
+    state->msip = 0;
+
+#if (RVE_E_SMP == 1)
+    state->mtime = 0;
+#endif
+#endif
+
+#if (RVE_E_A == 1)
+    // No reservation yet.
+    state->reservationvalid = 0;
+#endif
+
+#if (RVE_E_SMP == 1)
+    state->smp = 0;
+#endif
 }
 
 /**
@@ -61,7 +149,8 @@ static inline void RiscvEmulatorLoop(RiscvEmulatorState_t *state) {
 #if (RVE_E_C == 1)
     // Read 16 bits.
     state->instruction.H = 0;
-    RiscvEmulatorLoad(
+    RiscvEmulatorOpsFetch(
+        state,
         state->programcounter,
         &state->instruction.L,
         sizeof(state->instruction.L));
@@ -70,7 +159,8 @@ static inline void RiscvEmulatorLoop(RiscvEmulatorState_t *state) {
 
     // Read another 16 bits when this is a 32-bit instruction.
     if (state->instruction.copcode.op == OPCODE16_QUADRANT_INVALID) {
-        RiscvEmulatorLoad(
+        RiscvEmulatorOpsFetch(
+            state,
             state->programcounternext,
             &state->instruction.H,
             sizeof(state->instruction.L));
@@ -81,12 +171,29 @@ static inline void RiscvEmulatorLoop(RiscvEmulatorState_t *state) {
     }
 #else
     // Read 32 bits.
-    RiscvEmulatorLoad(state->programcounter, &state->instruction.value, sizeof(state->instruction.value));
+    RiscvEmulatorOpsFetch(state, state->programcounter, &state->instruction.value, sizeof(state->instruction.value));
     state->programcounternext += sizeof(state->instruction.value);
 #endif
 
+#if (RVE_E_CACHE == 1)
+#if (RVE_E_ASYNC == 1)
+    // Fetched when the instruction suspended, not again when it is executed again after RiscvEmulatorResume().
+    if (state->icache && state->pending.kind != PENDING_COMPLETED) {
+#else
+    if (state->icache) {
+#endif
+        RiscvEmulatorCacheAccess(
+            state->icache,
+            state->programcounter,
+            state->programcounter,
+            (uint8_t)(state->programcounternext - state->programcounter),
+            0);
+    }
+#endif
+
 #if (RVE_E_C == 1)
     if (instructionlength == 16) {
+        RiscvEmulatorEvent(state, EVENT_COMPRESSED);
         RiscvEmulatorOpcodeCompressed(state);
     }
 #endif
@@ -128,6 +235,7 @@ static inline void RiscvEmulatorLoop(RiscvEmulatorState_t *state) {
                 break;
 #if (RVE_E_A == 1)
             case OPCODE32_ATOMICMEMORYOPERATION:
+                RiscvEmulatorEvent(state, EVENT_ATOMIC);
                 RiscvEmulatorOpcodeAtomicMemoryOperation(state);
                 break;
 #endif
@@ -137,9 +245,86 @@ static inline void RiscvEmulatorLoop(RiscvEmulatorState_t *state) {
         }
     }
 
+#if (RVE_E_IDLE == 1)
+    // Backward jump or branch.
+    if (state->trapflag.value == 0 &&
+        state->programcounter - state->programcounternext < RVE_IDLE_WINDOW) {
+        RiscvEmulatorIdleBranch(state);
+    }
+#endif
+
+#if (RVE_E_TRACE == 1)
+    if (state->trace) {
+        RiscvEmulatorTraceInstruction(state);
+    }
+#endif
+
     if (state->trapflag.value > 0) {
         RiscvEmulatorTrap(state);
     }
 }
 
+#if (RVE_E_RUN == 1)
+/**
+ * Execute up to count instructions.
+ *
+ * Instructions are executed in chunks. Only between chunks the emulator looks at anything other than executing
+ * instructions, so a chunk normally covers all remaining instructions.
+ *
+ * Stops early when state->exitreason is set, see RiscvEmulatorExit().
+ *
+ * @return The number of instructions executed.
+ */
+static inline uint32_t RiscvEmulatorRun(RiscvEmulatorState_t *state, uint32_t count) {
+    uint32_t executed = 0;
+
+    while (executed < count && state->exitreason == EXIT_REASON_NONE) {
+        state->chunk = count - executed;
+#if (RVE_E_INTERRUPT == 1)
+        if (state->waiting) {
+            RiscvEmulatorWaitSkip(state);
+        }
+#endif
+#if (RVE_E_CLINT == 1)
+        RiscvEmulatorClintChunk(state);
+#endif
+#if (RVE_E_INTERRUPT == 1)
+        if (state->attention) {
+            RiscvEmulatorInterrupt(state);
+        }
+
+        // Return to the host instead of spinning, until it raises an interrupt.
+        if (state->waiting && RiscvEmulatorWaiting(state)) {
+            state->exitreason = EXIT_REASON_WFI;
+            state->chunk = 0;
+            break;
+        }
+#endif
+#if (RVE_E_PROFILE == 1)
+        if (state->profile) {
+            RiscvEmulatorProfileChunk(state);
+        }
+#endif
+        state->budget = state->chunk;
+
+        while (state->budget > 0) {
+            // Count the instruction before executing it, so it can end the chunk by setting the budget to 0.
+            state->budget--;
+            RiscvEmulatorLoop(state);
+        }
+
+        executed += state->chunk;
+        state->retired += state->chunk;
+#if (RVE_E_PROFILE == 1)
+        if (state->profile) {
+            RiscvEmulatorProfileInterval(state);
+        }
+#endif
+        state->chunk = 0;
+    }
+
+    return executed;
+}
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulator_HPP_
+#define RiscvEmulator_HPP_
+
+#include <stdint.h>
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_OPS != 1)
+#error "RiscvEmulator.hpp needs -D RVE_E_OPS=1"
+#endif
+
+#if (RVE_E_RUN != 1)
+#error "RiscvEmulator.hpp needs -D RVE_E_RUN=1"
+#endif
+
+#include "RiscvEmulator.h"
+
+/**
+ * Config with only the size of RAM.
+ */
+template <uint32_t RamLength>
+struct RiscvEmulatorRamConfig {
+    static constexpr uint32_t ramLength = RamLength;
+};
+
+/**
+ * Hooks stopping RiscvEmulatorRun() on an illegal instruction or ECALL.
+ */
+struct RiscvEmulatorDefaultHooks {
+    void illegalInstruction(RiscvEmulatorState_t &state) {
+        RiscvEmulatorExit(&state, EXIT_REASON_ERROR);
+    }
+
+#if (RVE_E_ZICSR == 1)
+    void unknownCSR(RiscvEmulatorState_t &) {
+    }
+#endif
+
+    void handleECALL(RiscvEmulatorState_t &state) {
+        RiscvEmulatorExit(&state, EXIT_REASON_EXIT);
+    }
+
+    void handleEBREAK(RiscvEmulatorState_t &) {
+    }
+};
+
+/**
+ * Emulator instance with memory and trap behavior chosen at compile time.
+ *
+ * Config provides ramLength. Bus provides load(), store() and, with RVE_E_SMP, hostAddress(), with the arguments of
+ * their counterparts in RiscvEmulatorImplementationSpecific.h. Hooks provides illegalInstruction(), unknownCSR() (with
+ * RVE_E_ZICSR), handleECALL() and handleEBREAK(), each receiving the state.
+ *
+ * Every instantiation gets its own operations table whose entries call Bus and Hooks directly, so their functions are
+ * inlined into the table and each access costs a single indirect call. Bus and Hooks are plain classes, so they can be
+ * tested without an emulator.
+ */
+template <typename Config, typename Bus, typename Hooks = RiscvEmulatorDefaultHooks>
+class RiscvEmulator {
+    static_assert(Config::ramLength > 0, "Config::ramLength must be larger than 0");
+
+  public:
+    Bus bus;
+    Hooks hooks;
+    RiscvEmulatorState_t state;
+
+    RiscvEmulator() {
+        init();
+    }
+
+    // The state points back at this instance.
+    RiscvEmulator(const RiscvEmulator &) = delete;
+    RiscvEmulator &operator=(const RiscvEmulator &) = delete;
+
+    /**
+     * Reset the state, leaving bus and hooks alone.
+     */
+    void init() {
+        RiscvEmulatorInit(&state, Config::ramLength);
+        state.ops = &ops;
+        state.context = this;
+    }
+
+    /**
+     * Execute a single instruction.
+     */
+    void loop() {
+        RiscvEmulatorLoop(&state);
+    }
+
+    /**
+     * Execute up to count instructions, see RiscvEmulatorRun().
+     */
+    uint32_t run(uint32_t count) {
+        return RiscvEmulatorRun(&state, count);
+    }
+
+    uint8_t exitReason() const {
+        return state.exitreason;
+    }
+
+  private:
+    static RiscvEmulator &self(RiscvEmulatorState_t *state) {
+        return *static_cast<RiscvEmulator *>(state->context);
+    }
+
+    static void load(RiscvEmulatorState_t *state, uint32_t address, void *destination, uint8_t length) {
+        self(state).bus.load(address, destination, length);
+    }
+
+    static void store(RiscvEmulatorState_t *state, uint32_t address, const void *source, uint8_t length) {
+        self(state).bus.store(address, source, length);
+    }
+
+    static void illegalInstruction(RiscvEmulatorState_t *state) {
+        self(state).hooks.illegalInstruction(*state);
+    }
+
+#if (RVE_E_ZICSR == 1)
+    static void unknownCSR(RiscvEmulatorState_t *state) {
+        self(state).hooks.unknownCSR(*state);
+    }
+#endif
+
+    static void handleECALL(RiscvEmulatorState_t *state) {
+        self(state).hooks.handleECALL(*state);
+    }
+
+    static void handleEBREAK(RiscvEmulatorState_t *state) {
+        self(state).hooks.handleEBREAK(*state);
+    }
+
+#if (RVE_E_SMP == 1)
+    static void *hostAddress(RiscvEmulatorState_t *state, uint32_t address) {
+        return self(state).bus.hostAddress(address);
+    }
+#endif
+
+    static const RiscvEmulatorOps_t ops;
+};
+
+template <typename Config, typename Bus, typename Hooks>
+const RiscvEmulatorOps_t RiscvEmulator<Config, Bus, Hooks>::ops = {
+    RiscvEmulator::load,
+    RiscvEmulator::store,
+    RiscvEmulator::illegalInstruction,
+#if (RVE_E_ZICSR == 1)
+    RiscvEmulator::unknownCSR,
+#endif
+    RiscvEmulator::handleECALL,
+    RiscvEmulator::handleEBREAK,
+#if (RVE_E_SMP == 1)
+    RiscvEmulator::hostAddress,
+#endif
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorAsync_H_
+#define RiscvEmulatorAsync_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_ASYNC == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulatorBudget.h"
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * Suspend the instance from a load, store or ECALL operation that cannot complete without blocking the host.
+ *
+ * A suspending load must leave its destination alone. RiscvEmulatorRun() returns with EXIT_REASON_PENDING and
+ * state->pending describing the I/O. Complete it with RiscvEmulatorResume().
+ */
+static inline void RiscvEmulatorSuspend(RiscvEmulatorState_t *state) {
+    state->pending.kind = PENDING_SUSPENDED;
+}
+
+/**
+ * Stop RiscvEmulatorRun() after an operation suspended.
+ *
+ * A load did not produce its value, so its instruction is undone and executed again when resumed. The completed load
+ * is then answered from state->pending. Stores and ECALLs are finished by the host and need no replay.
+ */
+static inline void RiscvEmulatorAsyncPending(RiscvEmulatorState_t *state, uint8_t kind, uint32_t address, const void *value, uint8_t length) {
+    state->pending.kind = kind;
+    state->pending.address = address;
+    state->pending.length = length;
+    state->pending.value = 0;
+
+    if (kind == PENDING_LOAD) {
+        state->programcounternext = state->programcounter;
+    } else if (value != 0) {
+        memcpy(&state->pending.value, value, length);
+    }
+
+    RiscvEmulatorExit(state, EXIT_REASON_PENDING);
+
+    // An undone instruction does not retire.
+    if (kind == PENDING_LOAD && state->chunk > 0) {
+        state->chunk--;
+    }
+}
+
+/**
+ * Answer a load executed again after RiscvEmulatorResume().
+ *
+ * @return 1 when the load was answered.
+ */
+static inline uint8_t RiscvEmulatorAsyncCompleted(RiscvEmulatorState_t *state, uint32_t address, void *destination, uint8_t length) {
+    if (state->pending.kind != PENDING_COMPLETED ||
+        state->pending.address != address ||
+        state->pending.length != length) {
+        return 0;
+    }
+
+    memcpy(destination, &state->pending.value, length);
+    state->pending.kind = PENDING_NONE;
+
+    return 1;
+}
+
+/**
+ * Continue an instance after the I/O it waited for has completed. Call RiscvEmulatorRun() again afterwards.
+ *
+ * @param value The value loaded, ignored for stores. After an ECALL set the registers in state->reg instead.
+ */
+static inline void RiscvEmulatorResume(RiscvEmulatorState_t *state, uint32_t value) {
+    if (state->pending.kind == PENDING_LOAD) {
+        state->pending.value = value;
+        state->pending.kind = PENDING_COMPLETED;
+    } else {
+        state->pending.kind = PENDING_NONE;
+    }
+
+    state->exitreason = EXIT_REASON_NONE;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorAtomic_H_
+#define RiscvEmulatorAtomic_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_SMP == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulatorOps.h"
+#include "RiscvEmulatorTypeSmp.h"
+
+/**
+ * Locks guarding atomic memory operations, one per group of 64-byte cache lines.
+ *
+ * Shared by all translation units, so it must be defined once in your implementation.
+ */
+extern RiscvEmulatorAtomicLock_t RiscvEmulatorAtomicLockTable[RVE_SMP_LOCKS];
+
+/**
+ * Get the lock guarding the cache line of an address.
+ */
+static inline uint8_t *RiscvEmulatorAtomicLockFlag(const uint32_t address) {
+    return &RiscvEmulatorAtomicLockTable[(address >> 6) & (RVE_SMP_LOCKS - 1)].flag;
+}
+
+/**
+ * Acquire exclusive access to the cache line of an address for an atomic memory operation.
+ *
+ * Spins on a plain load while the lock is taken so waiting harts do not keep bouncing the cache line.
+ */
+static inline void RiscvEmulatorAtomicLock(const uint32_t address) {
+    uint8_t *flag = RiscvEmulatorAtomicLockFlag(address);
+    while (__atomic_test_and_set(flag, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(flag, __ATOMIC_RELAXED)) {
+        }
+    }
+}
+
+/**
+ * Release exclusive access acquired by RiscvEmulatorAtomicLock().
+ */
+static inline void RiscvEmulatorAtomicUnlock(const uint32_t address) {
+    __atomic_clear(RiscvEmulatorAtomicLockFlag(address), __ATOMIC_RELEASE);
+}
+
+/**
+ * Get the host pointer of an aligned word in RAM for executing an atomic memory operation with host atomics.
+ *
+ * @return 0 when the address is misaligned or not backed by host RAM.
+ */
+static inline uint32_t *RiscvEmulatorAtomicHostAddress(RiscvEmulatorState_t *state, const uint32_t address) {
+    if ((address & 0b11) != 0) {
+        return 0;
+    }
+
+    return (uint32_t *)RiscvEmulatorOpsHostAddress(state, address);
+}
+
+/**
+ * Order earlier memory accesses before an atomic memory operation with the rl bit set.
+ *
+ * With both aq and rl set the operation is sequentially consistent.
+ */
+static inline void RiscvEmulatorAtomicReleaseFence(const uint8_t aq, const uint8_t rl) {
+    if (rl == 1) {
+        if (aq == 1) {
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        } else {
+            __atomic_thread_fence(__ATOMIC_RELEASE);
+        }
+    }
+}
+
+/**
+ * Order later memory accesses after an atomic memory operation with the aq bit set.
+ *
+ * With both aq and rl set the operation is sequentially consistent.
+ */
+static inline void RiscvEmulatorAtomicAcquireFence(const uint8_t aq, const uint8_t rl) {
+    if (aq == 1) {
+        if (rl == 1) {
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        } else {
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        }
+    }
+}
+
+#endif
+
+#endif
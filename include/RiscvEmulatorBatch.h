@@ -0,0 +1,295 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorBatch_H_
+#define RiscvEmulatorBatch_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_BATCH == 1)
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "RiscvEmulator.h"
+#include "RiscvEmulatorLockstep.h"
+#include "RiscvEmulatorTypeBatch.h"
+
+#if (RVE_E_LOCKSTEP == 1)
+// Jobs scheduled together.
+#define BATCH_UNIT_JOBS RVE_LOCKSTEP_LANES
+#else
+#define BATCH_UNIT_JOBS 1
+#endif
+
+/**
+ * Units of jobs waiting for a worker. The owning worker takes units from the bottom, other workers steal from the top.
+ */
+typedef struct {
+    pthread_mutex_t mutex;
+    uint32_t *unit;
+    uint32_t top;
+    uint32_t size;
+} RiscvEmulatorBatchQueue_t;
+
+typedef struct {
+    RiscvEmulatorBatchJob_t *job;
+    uint32_t jobcount;
+    uint32_t unitcount;
+    uint32_t quantum;
+    RiscvEmulatorBatchQueue_t *queue;
+    uint8_t workercount;
+
+    /**
+     * Hands out a queue to each starting worker.
+     */
+    uint8_t started;
+
+    /**
+     * Units waiting in the queues, not running on a worker.
+     */
+    uint32_t queued;
+} RiscvEmulatorBatch_t;
+
+/**
+ * Queue a unit at the bottom of a queue.
+ *
+ * Queues are rings of unitcount slots, a unit is never queued twice so they cannot overflow.
+ */
+static inline void RiscvEmulatorBatchPush(RiscvEmulatorBatch_t *batch, RiscvEmulatorBatchQueue_t *queue, uint32_t unitnum) {
+    pthread_mutex_lock(&queue->mutex);
+    queue->unit[(queue->top + queue->size) % batch->unitcount] = unitnum;
+    queue->size++;
+    __atomic_fetch_add(&batch->queued, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+/**
+ * Take a unit from the bottom or top of a queue.
+ *
+ * @return 1 when a unit was taken.
+ */
+static inline uint8_t RiscvEmulatorBatchTake(RiscvEmulatorBatch_t *batch, RiscvEmulatorBatchQueue_t *queue, uint8_t steal, uint32_t *unitnum) {
+    uint8_t taken = 0;
+
+    pthread_mutex_lock(&queue->mutex);
+    if (queue->size > 0) {
+        queue->size--;
+        if (steal) {
+            *unitnum = queue->unit[queue->top];
+            queue->top = (queue->top + 1) % batch->unitcount;
+        } else {
+            *unitnum = queue->unit[(queue->top + queue->size) % batch->unitcount];
+        }
+        __atomic_fetch_sub(&batch->queued, 1, __ATOMIC_RELEASE);
+        taken = 1;
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    return taken;
+}
+
+/**
+ * Run a unit for one quantum.
+ *
+ * @return 1 when all jobs of the unit are finished.
+ */
+static inline uint8_t RiscvEmulatorBatchStep(RiscvEmulatorBatch_t *batch, uint32_t unitnum) {
+    RiscvEmulatorBatchJob_t *job = &batch->job[unitnum * BATCH_UNIT_JOBS];
+
+#if (RVE_E_LOCKSTEP == 1)
+    uint32_t lanecount = batch->jobcount - unitnum * BATCH_UNIT_JOBS;
+    if (lanecount > BATCH_UNIT_JOBS) {
+        lanecount = BATCH_UNIT_JOBS;
+    }
+
+    return RiscvEmulatorLockstepRun(job, lanecount, batch->quantum) == 0;
+#else
+    uint32_t count = batch->quantum;
+
+    if (job->limit > 0) {
+        // The state may already have run past the limit before it was handed to the batch.
+        if (job->state->retired >= job->limit) {
+            job->exitreason = EXIT_REASON_LIMIT;
+            return 1;
+        }
+
+        uint64_t left = job->limit - job->state->retired;
+        if (left < count) {
+            count = (uint32_t)left;
+        }
+    }
+
+    RiscvEmulatorBatchMemory = job->memory;
+    RiscvEmulatorRun(job->state, count);
+
+    if (job->state->exitreason != EXIT_REASON_NONE) {
+        job->exitreason = job->state->exitreason;
+        return 1;
+    }
+
+    if (job->limit > 0 && job->state->retired >= job->limit) {
+        job->exitreason = EXIT_REASON_LIMIT;
+        return 1;
+    }
+
+    return 0;
+#endif
+}
+
+/**
+ * Worker running jobs from its own queue, stealing from other queues when it runs dry.
+ *
+ * An unfinished job goes back to the bottom of the queue of the worker that ran it, so it keeps running on the same
+ * host core while it is warm in cache. Idle workers steal the jobs that have waited the longest and stop when nothing
+ * is queued.
+ */
+static void *RiscvEmulatorBatchWorker(void *argument) {
+    RiscvEmulatorBatch_t *batch = (RiscvEmulatorBatch_t *)argument;
+
+    // Claim the next queue.
+    uint8_t workernum = __atomic_fetch_add(&batch->started, 1, __ATOMIC_RELAXED);
+    RiscvEmulatorBatchQueue_t *own = &batch->queue[workernum];
+
+    for (;;) {
+        uint32_t unitnum;
+        uint8_t taken = RiscvEmulatorBatchTake(batch, own, 0, &unitnum);
+
+        for (uint8_t victim = 1; !taken && victim < batch->workercount; victim++) {
+            taken = RiscvEmulatorBatchTake(batch, &batch->queue[(workernum + victim) % batch->workercount], 1, &unitnum);
+        }
+
+        if (!taken) {
+            // Units are never added, the ones left are running on workers that queue them for themselves.
+            if (__atomic_load_n(&batch->queued, __ATOMIC_ACQUIRE) == 0) {
+                break;
+            }
+
+            // A unit was queued while the queues were searched.
+            continue;
+        }
+
+        if (!RiscvEmulatorBatchStep(batch, unitnum)) {
+            RiscvEmulatorBatchPush(batch, own, unitnum);
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Run all jobs to completion on a pool of host threads.
+ *
+ * Every job needs an initialized state, jobs with an exit reason in their state are skipped. The implementation finds
+ * the memory of the running job in RiscvEmulatorBatchMemory and ends a job with RiscvEmulatorExit().
+ *
+ * @param workercount The number of host threads, 1 runs all jobs on the calling thread.
+ * With RVE_E_LOCKSTEP every RVE_LOCKSTEP_LANES consecutive jobs are scheduled together and run in lockstep, see
+ * RiscvEmulatorLockstepRun().
+ *
+ * @param quantum Instructions a job executes before it can move to another worker.
+ * @return 0 on success, ENOMEM or the error of pthread_mutex_init() when nothing was run, otherwise the error of
+ * pthread_create(). When fewer host threads could be started all jobs are still run on the ones that did.
+ */
+static inline int RiscvEmulatorBatchRun(RiscvEmulatorBatchJob_t *job, uint32_t jobcount, uint8_t workercount, uint32_t quantum) {
+    int error = 0;
+
+    if (jobcount == 0) {
+        return 0;
+    }
+
+    if (workercount == 0) {
+        workercount = 1;
+    }
+
+    if (quantum == 0) {
+        quantum = 1;
+    }
+
+    RiscvEmulatorBatch_t batch = {0};
+    batch.job = job;
+    batch.jobcount = jobcount;
+    batch.unitcount = (jobcount + BATCH_UNIT_JOBS - 1) / BATCH_UNIT_JOBS;
+    batch.quantum = quantum;
+    batch.workercount = workercount;
+
+    batch.queue = (RiscvEmulatorBatchQueue_t *)calloc(workercount, sizeof(RiscvEmulatorBatchQueue_t));
+    pthread_t *thread = (pthread_t *)calloc(workercount, sizeof(pthread_t));
+    uint32_t *slot = (uint32_t *)calloc((size_t)workercount * batch.unitcount, sizeof(uint32_t));
+    if (batch.queue == 0 || thread == 0 || slot == 0) {
+        free(slot);
+        free(thread);
+        free(batch.queue);
+        return ENOMEM;
+    }
+
+    for (uint8_t workernum = 0; workernum < workercount; workernum++) {
+        error = pthread_mutex_init(&batch.queue[workernum].mutex, 0);
+        if (error != 0) {
+            while (workernum > 0) {
+                workernum--;
+                pthread_mutex_destroy(&batch.queue[workernum].mutex);
+            }
+            free(slot);
+            free(thread);
+            free(batch.queue);
+            return error;
+        }
+        batch.queue[workernum].unit = &slot[(size_t)workernum * batch.unitcount];
+    }
+
+    // Spread units with unfinished jobs over the queues.
+    uint32_t unfinishedcount = 0;
+    for (uint32_t unitnum = 0; unitnum < batch.unitcount; unitnum++) {
+        uint8_t unfinished = 0;
+
+        for (uint32_t jobnum = unitnum * BATCH_UNIT_JOBS; jobnum < jobcount && jobnum < (unitnum + 1) * BATCH_UNIT_JOBS; jobnum++) {
+            job[jobnum].exitreason = job[jobnum].state->exitreason;
+            if (job[jobnum].exitreason == EXIT_REASON_NONE) {
+                unfinished = 1;
+            }
+        }
+
+        if (unfinished) {
+            RiscvEmulatorBatchPush(&batch, &batch.queue[unfinishedcount % workercount], unitnum);
+            unfinishedcount++;
+        }
+    }
+
+    // The calling thread is the last worker.
+    uint8_t threadcount = 0;
+    while (threadcount < workercount - 1) {
+        error = pthread_create(&thread[threadcount], 0, RiscvEmulatorBatchWorker, &batch);
+        if (error != 0) {
+            break;
+        }
+        threadcount++;
+    }
+
+    // Queues of workers that never started are emptied by stealing.
+    RiscvEmulatorBatchWorker(&batch);
+
+    for (uint8_t threadnum = 0; threadnum < threadcount; threadnum++) {
+        pthread_join(thread[threadnum], 0);
+    }
+
+    for (uint8_t workernum = 0; workernum < workercount; workernum++) {
+        pthread_mutex_destroy(&batch.queue[workernum].mutex);
+    }
+
+    free(slot);
+    free(thread);
+    free(batch.queue);
+
+    return error;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorBudget_H_
+#define RiscvEmulatorBudget_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_RUN == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * End the current chunk of RiscvEmulatorRun() after the instruction being executed.
+ *
+ * RiscvEmulatorRun() only checks for work between chunks, call this when that work must not wait.
+ */
+static inline void RiscvEmulatorEndChunk(RiscvEmulatorState_t *state) {
+    state->chunk -= state->budget;
+    state->budget = 0;
+}
+
+/**
+ * Stop RiscvEmulatorRun() after the instruction being executed.
+ *
+ * @param exitreason One of EXIT_REASON_*, or a value of your own starting at EXIT_REASON_USER.
+ */
+static inline void RiscvEmulatorExit(RiscvEmulatorState_t *state, const uint8_t exitreason) {
+    state->exitreason = exitreason;
+    RiscvEmulatorEndChunk(state);
+}
+
+/**
+ * Number of instructions retired by RiscvEmulatorRun(), including the instruction being executed.
+ */
+static inline uint64_t RiscvEmulatorRetired(const RiscvEmulatorState_t *state) {
+    return state->retired + (state->chunk - state->budget);
+}
+
+#endif
+
+#endif
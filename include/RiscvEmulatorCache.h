@@ -0,0 +1,205 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorCache_H_
+#define RiscvEmulatorCache_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_CACHE == 1)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+#if (RVE_CACHE_PROGRAMCOUNTERS & (RVE_CACHE_PROGRAMCOUNTERS - 1)) != 0
+#error "RVE_CACHE_PROGRAMCOUNTERS must be a power of 2"
+#endif
+
+/**
+ * Prepare an empty cache before attaching it to an instance with state->icache or state->dcache.
+ *
+ * @param size Size in bytes, a power of 2.
+ * @param ways Number of lines per set, a power of 2, 1 for a direct mapped cache.
+ * @param linesize Size of a line in bytes, a power of 2.
+ * @param policy One of CACHE_POLICY_*.
+ * @return 1 when the cache fits in RVE_CACHE_LINES lines.
+ */
+static inline uint8_t RiscvEmulatorCacheInit(RiscvEmulatorCache_t *cache, uint32_t size, uint32_t ways, uint32_t linesize, uint8_t policy) {
+    if (size == 0 || ways == 0 || linesize == 0 ||
+        (size & (size - 1)) != 0 || (ways & (ways - 1)) != 0 || (linesize & (linesize - 1)) != 0 ||
+        size / linesize < ways || size / linesize > RVE_CACHE_LINES) {
+        return 0;
+    }
+
+    cache->lineshift = 0;
+    while ((UINT32_C(1) << cache->lineshift) < linesize) {
+        cache->lineshift++;
+    }
+
+    cache->policy = policy;
+    cache->sets = size / linesize / ways;
+    cache->ways = ways;
+    cache->clock = 0;
+    cache->random = 0x12345678;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->writebacks = 0;
+    cache->overflow = 0;
+    memset(cache->line, 0, sizeof(cache->line));
+    memset(cache->programcounter, 0, sizeof(cache->programcounter));
+    return 1;
+}
+
+/**
+ * Look up the line holding address, replacing a line of its set on a miss. Write-back with write-allocate.
+ *
+ * @return 1 on a hit.
+ */
+static inline uint8_t RiscvEmulatorCacheLine(RiscvEmulatorCache_t *cache, uint32_t address, uint8_t write) {
+    uint32_t tag = address >> cache->lineshift;
+    RiscvEmulatorCacheLine_t *set = &cache->line[(tag & (cache->sets - 1)) * cache->ways];
+
+    cache->clock++;
+
+    for (uint32_t way = 0; way < cache->ways; way++) {
+        if (set[way].valid && set[way].tag == tag) {
+            if (cache->policy == CACHE_POLICY_LRU) {
+                set[way].stamp = cache->clock;
+            }
+            set[way].dirty |= write;
+            cache->hits++;
+            return 1;
+        }
+    }
+
+    cache->misses++;
+
+    // An empty line first.
+    RiscvEmulatorCacheLine_t *victim = 0;
+    for (uint32_t way = 0; way < cache->ways && victim == 0; way++) {
+        if (set[way].valid == 0) {
+            victim = &set[way];
+        }
+    }
+
+    if (victim == 0) {
+        if (cache->policy == CACHE_POLICY_RANDOM) {
+            cache->random ^= cache->random << 13;
+            cache->random ^= cache->random >> 17;
+            cache->random ^= cache->random << 5;
+            victim = &set[cache->random & (cache->ways - 1)];
+        } else {
+            // Least recently used or first filled.
+            victim = &set[0];
+            for (uint32_t way = 1; way < cache->ways; way++) {
+                if (set[way].stamp < victim->stamp) {
+                    victim = &set[way];
+                }
+            }
+        }
+
+        if (victim->dirty) {
+            cache->writebacks++;
+        }
+    }
+
+    victim->tag = tag;
+    victim->valid = 1;
+    victim->dirty = write;
+    victim->stamp = cache->clock;
+    return 0;
+}
+
+/**
+ * Simulate an access, counting it as a hit or a miss of the instruction at programcounter.
+ *
+ * An access crossing two lines is a miss when either line misses.
+ */
+static inline void RiscvEmulatorCacheAccess(
+    RiscvEmulatorCache_t *cache,
+    uint32_t programcounter,
+    uint32_t address,
+    uint8_t length,
+    uint8_t write) {
+    uint8_t hit = RiscvEmulatorCacheLine(cache, address, write);
+
+    uint32_t last = address + length - 1;
+    if ((last >> cache->lineshift) != (address >> cache->lineshift)) {
+        hit &= RiscvEmulatorCacheLine(cache, last, write);
+    }
+
+    uint32_t slot = ((programcounter >> 1) * UINT32_C(0x9e3779b1)) & (RVE_CACHE_PROGRAMCOUNTERS - 1);
+    // A few slots only, a full table would otherwise be searched on every access.
+    for (uint32_t probe = 0; probe < RVE_CACHE_PROBES && probe < RVE_CACHE_PROGRAMCOUNTERS; probe++) {
+        RiscvEmulatorCacheProgramCounter_t *entry = &cache->programcounter[(slot + probe) & (RVE_CACHE_PROGRAMCOUNTERS - 1)];
+        if (entry->programcounter == programcounter || (entry->hits == 0 && entry->misses == 0)) {
+            entry->programcounter = programcounter;
+            if (hit) {
+                entry->hits++;
+            } else {
+                entry->misses++;
+            }
+            return;
+        }
+    }
+
+    cache->overflow++;
+}
+
+/**
+ * Count a load of the instruction being executed in the data cache.
+ */
+static inline void RiscvEmulatorCacheLoad(RiscvEmulatorState_t *state, uint32_t address, uint8_t length) {
+    if (state->dcache == 0) {
+        return;
+    }
+
+    RiscvEmulatorCacheAccess(state->dcache, state->programcounter, address, length, 0);
+}
+
+/**
+ * Count a store of the instruction being executed in the data cache.
+ */
+static inline void RiscvEmulatorCacheStore(RiscvEmulatorState_t *state, uint32_t address, uint8_t length) {
+    if (state->dcache == 0) {
+        return;
+    }
+
+    RiscvEmulatorCacheAccess(state->dcache, state->programcounter, address, length, 1);
+}
+
+/**
+ * List the program counters in the cache, most misses first.
+ *
+ * @param index Room for RVE_CACHE_PROGRAMCOUNTERS numbers, filled with indexes in cache->programcounter.
+ * @return The number of program counters listed.
+ */
+static inline uint32_t RiscvEmulatorCacheSort(const RiscvEmulatorCache_t *cache, uint32_t *index) {
+    uint32_t count = 0;
+
+    for (uint32_t entry = 0; entry < RVE_CACHE_PROGRAMCOUNTERS; entry++) {
+        if (cache->programcounter[entry].hits == 0 && cache->programcounter[entry].misses == 0) {
+            continue;
+        }
+
+        uint32_t position = count++;
+        while (position > 0 && cache->programcounter[index[position - 1]].misses < cache->programcounter[entry].misses) {
+            index[position] = index[position - 1];
+            position--;
+        }
+        index[position] = entry;
+    }
+
+    return count;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorClint_H_
+#define RiscvEmulatorClint_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_CLINT == 1)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RiscvEmulatorBudget.h"
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorInterrupt.h"
+#include "RiscvEmulatorType.h"
+#include "RiscvEmulatorTypeSmp.h"
+
+/**
+ * Latest mtime of the harts sharing the CLINT with this one, or mtime when it is later.
+ *
+ * Every hart counts its own instructions, the shared mtime is that of the hart furthest ahead.
+ */
+static inline uint64_t RiscvEmulatorClintShared(const RiscvEmulatorState_t *state __attribute__((unused)), uint64_t mtime) {
+#if (RVE_E_SMP == 1)
+    if (state->smp) {
+        for (uint8_t hartid = 0; hartid < state->smp->hartcount; hartid++) {
+            uint64_t other = __atomic_load_n(&state->smp->hart[hartid].mtime, __ATOMIC_RELAXED);
+            if (other > mtime) {
+                mtime = other;
+            }
+        }
+    }
+#endif
+
+    return mtime;
+}
+
+/**
+ * Current value of mtime, one tick per instruction retired.
+ */
+static inline uint64_t RiscvEmulatorClintTime(const RiscvEmulatorState_t *state) {
+    return RiscvEmulatorClintShared(state, RiscvEmulatorRetired(state) + state->mtimeoffset);
+}
+
+/**
+ * Set mtime, for example from a host clock between runs.
+ *
+ * With RVE_E_SMP mtime is shared by all harts and only moves forward.
+ */
+static inline void RiscvEmulatorClintSetTime(RiscvEmulatorState_t *state, uint64_t mtime) {
+    state->mtimeoffset = mtime - RiscvEmulatorRetired(state);
+}
+
+/**
+ * Update MSIP and MTIP and shorten the chunk about to start so it ends at the next timer deadline.
+ *
+ * Called by RiscvEmulatorRun() before every chunk, so the CLINT is not looked at while executing instructions. Other
+ * harts write msip and mtimecmp of this hart, so they are read atomically.
+ */
+static inline void RiscvEmulatorClintChunk(RiscvEmulatorState_t *state) {
+    uint32_t mip = state->csr.mip.mip & ~MIP_MSIP;
+    if (__atomic_load_n(&state->msip, __ATOMIC_RELAXED)) {
+        mip |= MIP_MSIP;
+    }
+
+    // Between chunks all instructions are counted in retired.
+    uint64_t mtime = state->retired + state->mtimeoffset;
+#if (RVE_E_SMP == 1)
+    // Catch up with the hart furthest ahead, and tell the others how far this one is.
+    uint64_t shared = RiscvEmulatorClintShared(state, mtime);
+    state->mtimeoffset += shared - mtime;
+    mtime = shared;
+    __atomic_store_n(&state->mtime, mtime, __ATOMIC_RELAXED);
+#endif
+
+    uint64_t mtimecmp = __atomic_load_n(&state->mtimecmp, __ATOMIC_RELAXED);
+    if (mtime >= mtimecmp) {
+        mip |= MIP_MTIP;
+    } else {
+        mip &= ~MIP_MTIP;
+
+        if (mtimecmp - mtime < state->chunk) {
+            state->chunk = (uint32_t)(mtimecmp - mtime);
+        }
+    }
+
+#if (RVE_E_INTERRUPT == 1)
+    if ((mip & ~state->csr.mip.mip) != 0) {
+        state->attention = 1;
+    }
+#endif
+    state->csr.mip.mip = mip;
+}
+
+/**
+ * Get the hart of the msip or mtimecmp register with index hartid.
+ *
+ * @return 0 when there is no such hart.
+ */
+static inline RiscvEmulatorState_t *RiscvEmulatorClintHart(RiscvEmulatorState_t *state, uint32_t hartid) {
+#if (RVE_E_SMP == 1)
+    if (state->smp) {
+        return hartid < state->smp->hartcount ? &state->smp->hart[hartid] : 0;
+    }
+#endif
+
+    return hartid == 0 ? state : 0;
+}
+
+/**
+ * Get the value of the 32 or 64-bit register at offset, with its offset in base.
+ *
+ * @param hart Receives the hart of an msip or mtimecmp register, 0 for mtime or a reserved offset.
+ */
+static inline uint64_t RiscvEmulatorClintRegister(
+    RiscvEmulatorState_t *state,
+    uint32_t offset,
+    uint32_t *base,
+    RiscvEmulatorState_t **hart) {
+    *hart = 0;
+
+    if (offset >= CLINT_MTIME && offset < CLINT_MTIME + sizeof(uint64_t)) {
+        *base = CLINT_MTIME;
+        return RiscvEmulatorClintTime(state);
+    }
+
+    if (offset >= CLINT_MTIMECMP) {
+        *hart = RiscvEmulatorClintHart(state, (offset - CLINT_MTIMECMP) / sizeof(uint64_t));
+        if (*hart) {
+            *base = offset & ~(uint32_t)(sizeof(uint64_t) - 1);
+            return __atomic_load_n(&(*hart)->mtimecmp, __ATOMIC_RELAXED);
+        }
+    } else {
+        *hart = RiscvEmulatorClintHart(state, (offset - CLINT_MSIP) / sizeof(uint32_t));
+        if (*hart) {
+            *base = offset & ~(uint32_t)(sizeof(uint32_t) - 1);
+            return __atomic_load_n(&(*hart)->msip, __ATOMIC_RELAXED);
+        }
+    }
+
+    // Reserved, reads as 0.
+    *base = offset;
+    return 0;
+}
+
+/**
+ * Load from the CLINT.
+ */
+static inline void RiscvEmulatorClintLoad(RiscvEmulatorState_t *state, uint32_t address, void *destination, uint8_t length) {
+    uint32_t base;
+    RiscvEmulatorState_t *hart;
+    uint64_t value = RiscvEmulatorClintRegister(state, address - CLINT_ORIGIN, &base, &hart);
+
+    memset(destination, 0, length);
+    uint32_t shift = address - CLINT_ORIGIN - base;
+    if (shift < sizeof(value)) {
+        memcpy(destination, (uint8_t *)&value + shift, length <= sizeof(value) - shift ? length : sizeof(value) - shift);
+    }
+}
+
+/**
+ * Store to the CLINT.
+ *
+ * Ends the chunk, so RiscvEmulatorRun() takes the new deadline into account. Another hart sees a change of its msip or
+ * mtimecmp at the end of its current chunk, at most a quantum later.
+ */
+static inline void RiscvEmulatorClintStore(RiscvEmulatorState_t *state, uint32_t address, const void *source, uint8_t length) {
+    uint32_t base;
+    RiscvEmulatorState_t *hart;
+    uint64_t value = RiscvEmulatorClintRegister(state, address - CLINT_ORIGIN, &base, &hart);
+
+    uint32_t shift = address - CLINT_ORIGIN - base;
+    if (shift >= sizeof(value)) {
+        return;
+    }
+    memcpy((uint8_t *)&value + shift, source, length <= sizeof(value) - shift ? length : sizeof(value) - shift);
+
+    if (base == CLINT_MTIME) {
+        RiscvEmulatorClintSetTime(state, value);
+    } else if (hart == 0) {
+        return;
+    } else if (base >= CLINT_MTIMECMP) {
+        __atomic_store_n(&hart->mtimecmp, value, __ATOMIC_RELAXED);
+    } else {
+        __atomic_store_n(&hart->msip, (uint8_t)(value & 1), __ATOMIC_RELAXED);
+    }
+
+#if (RVE_E_INTERRUPT == 1)
+    RiscvEmulatorAttention(state);
+#else
+    RiscvEmulatorEndChunk(state);
+#endif
+}
+
+#endif
+
+#endif
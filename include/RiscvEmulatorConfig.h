@@ -28,6 +28,49 @@
 #define RVE_E_ZICSR 0
 #endif
 
+#if (RVE_E_ZICSR == 1)
+// Base counters and timers.
+#ifndef RVE_E_ZICNTR
+#define RVE_E_ZICNTR 0
+#endif
+
+#if (RVE_E_ZICNTR == 1)
+// Hardware performance counters counting emulator events.
+#ifndef RVE_E_ZIHPM
+#define RVE_E_ZIHPM 0
+#endif
+#endif
+
+// Machine-mode interrupts, delivered by RiscvEmulatorRun().
+#ifndef RVE_E_INTERRUPT
+#define RVE_E_INTERRUPT 0
+#endif
+
+#if (RVE_E_INTERRUPT == 1)
+// Park the hart like WFI when it loops without side effects.
+#ifndef RVE_E_IDLE
+#define RVE_E_IDLE 0
+#endif
+
+#if (RVE_E_IDLE == 1)
+// Maximum length in bytes of a loop looked at.
+#ifndef RVE_IDLE_WINDOW
+#define RVE_IDLE_WINDOW 64
+#endif
+
+// Iterations of a loop between comparing registers.
+#ifndef RVE_IDLE_ITERATIONS
+#define RVE_IDLE_ITERATIONS 16
+#endif
+#endif
+#endif
+
+// Core-local interruptor with machine timer and software interrupt.
+#ifndef RVE_E_CLINT
+#define RVE_E_CLINT 0
+#endif
+#endif
+
 // Instruction-Fetch Fence.
 #ifndef RVE_E_ZIFENCEI
 #define RVE_E_ZIFENCEI 0
@@ -53,9 +96,179 @@
 #define RVE_E_ZBS 0
 #endif
 
+// Multiple harts sharing memory, each hart running on its own host thread.
+#ifndef RVE_E_SMP
+#define RVE_E_SMP 0
+#endif
+
+#if (RVE_E_SMP == 1)
+// Maximum number of harts.
+#ifndef RVE_SMP_HARTS
+#define RVE_SMP_HARTS 4
+#endif
+
+// Number of locks guarding atomic memory operations, must be a power of 2.
+#ifndef RVE_SMP_LOCKS
+#define RVE_SMP_LOCKS 256
+#endif
+
+// Default number of instructions a hart executes before the scheduler looks at it again.
+#ifndef RVE_SMP_QUANTUM
+#define RVE_SMP_QUANTUM 1000
+#endif
+#endif
+
+// Run many independent instances on a pool of host threads.
+#ifndef RVE_E_BATCH
+#define RVE_E_BATCH 0
+#endif
+
+#if (RVE_E_BATCH == 1)
+// Run groups of batch jobs executing the same code in lockstep.
+#ifndef RVE_E_LOCKSTEP
+#define RVE_E_LOCKSTEP 0
+#endif
+
+#if (RVE_E_LOCKSTEP == 1)
+// Number of jobs in a group.
+#ifndef RVE_LOCKSTEP_LANES
+#define RVE_LOCKSTEP_LANES 8
+#endif
+#endif
+#endif
+
+// Operations table and context pointer per instance instead of RiscvEmulatorImplementationSpecific.h.
+#ifndef RVE_E_OPS
+#define RVE_E_OPS 0
+#endif
+
+#if (RVE_E_OPS == 1)
+// Operations can suspend the instance while waiting for slow I/O.
+#ifndef RVE_E_ASYNC
+#define RVE_E_ASYNC 0
+#endif
+#endif
+
 // Enable weak function hook.
 #ifndef RVE_E_HOOK
 #define RVE_E_HOOK 0
 #endif
 
+// Count executed instructions per HOOK_INSTRUCTION_* number.
+#ifndef RVE_E_HISTOGRAM
+#define RVE_E_HISTOGRAM 0
+#endif
+
+// Sample the program counter and follow calls to profile the guest.
+#ifndef RVE_E_PROFILE
+#define RVE_E_PROFILE 0
+#endif
+
+#if (RVE_E_PROFILE == 1)
+// Number of nodes in the call tree of a profile.
+#ifndef RVE_PROFILE_NODES
+#define RVE_PROFILE_NODES 4096
+#endif
+#endif
+
+// Count data memory accesses per cache line for a heatmap.
+#ifndef RVE_E_HEATMAP
+#define RVE_E_HEATMAP 0
+#endif
+
+#if (RVE_E_HEATMAP == 1)
+// Number of cache lines counted from the origin of a heatmap.
+#ifndef RVE_HEATMAP_LINES
+#define RVE_HEATMAP_LINES 4096
+#endif
+
+// Size of a cache line as a power of 2.
+#ifndef RVE_HEATMAP_LINE_SHIFT
+#define RVE_HEATMAP_LINE_SHIFT 6
+#endif
+#endif
+
+// Simulate an instruction cache and a data cache.
+#ifndef RVE_E_CACHE
+#define RVE_E_CACHE 0
+#endif
+
+#if (RVE_E_CACHE == 1)
+// Most lines of a simulated cache.
+#ifndef RVE_CACHE_LINES
+#define RVE_CACHE_LINES 1024
+#endif
+
+// Number of program counters with hits and misses of their own, must be a power of 2.
+#ifndef RVE_CACHE_PROGRAMCOUNTERS
+#define RVE_CACHE_PROGRAMCOUNTERS 4096
+#endif
+
+// Slots looked at for a program counter before its accesses are counted in overflow.
+#ifndef RVE_CACHE_PROBES
+#define RVE_CACHE_PROBES 16
+#endif
+#endif
+
+// Simulate a branch predictor.
+#ifndef RVE_E_PREDICTOR
+#define RVE_E_PREDICTOR 0
+#endif
+
+#if (RVE_E_PREDICTOR == 1)
+// Most 2-bit counters of the direction predictor.
+#ifndef RVE_PREDICTOR_COUNTERS
+#define RVE_PREDICTOR_COUNTERS 4096
+#endif
+
+// Most entries of the branch target buffer.
+#ifndef RVE_PREDICTOR_TARGETS
+#define RVE_PREDICTOR_TARGETS 512
+#endif
+
+// Most entries of the return address stack.
+#ifndef RVE_PREDICTOR_RETURNS
+#define RVE_PREDICTOR_RETURNS 16
+#endif
+
+// Number of program counters with predictions of their own, must be a power of 2.
+#ifndef RVE_PREDICTOR_PROGRAMCOUNTERS
+#define RVE_PREDICTOR_PROGRAMCOUNTERS 4096
+#endif
+
+// Slots looked at for a program counter before it is counted in overflow.
+#ifndef RVE_PREDICTOR_PROBES
+#define RVE_PREDICTOR_PROBES 16
+#endif
+#endif
+
+// Trace executed instructions to a ring buffer read by another thread.
+#ifndef RVE_E_TRACE
+#define RVE_E_TRACE 0
+#endif
+
+#if (RVE_E_TRACE == 1)
+// Number of records in the ring buffer, must be a power of 2.
+#ifndef RVE_TRACE_LENGTH
+#define RVE_TRACE_LENGTH 4096
+#endif
+
+// Number of records between seek points of an encoded trace.
+#ifndef RVE_TRACE_SEEK_INTERVAL
+#define RVE_TRACE_SEEK_INTERVAL 65536
+#endif
+#endif
+
+// RiscvEmulatorRun(), executing instructions in chunks until RiscvEmulatorExit().
+#ifndef RVE_E_RUN
+#define RVE_E_RUN 0
+#endif
+
+// Counting retired instructions or stopping between instructions needs RiscvEmulatorRun().
+#if (RVE_E_SMP == 1) || (RVE_E_BATCH == 1) || (RVE_E_ASYNC == 1) || (RVE_E_ZICNTR == 1) || (RVE_E_INTERRUPT == 1) || \
+    (RVE_E_CLINT == 1) || (RVE_E_PROFILE == 1)
+#undef RVE_E_RUN
+#define RVE_E_RUN 1
+#endif
+
 #endif
\ No newline at end of file
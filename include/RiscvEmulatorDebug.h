@@ -10,6 +10,9 @@
 
 #include <stdint.h>
 
+#include "RiscvEmulatorConfig.h"
+#include "RiscvEmulatorDefineHook.h"
+
 /**
  * Debug function for returning the symbolic name of a register.
  */
@@ -154,6 +157,40 @@ const char *RiscvEmulatorGetCSRName(const uint16_t csr) {
             name = "satp";
             break;
 
+        // Machine Counter/Timers
+        case 0xB00:
+            name = "mcycle";
+            break;
+        case 0xB02:
+            name = "minstret";
+            break;
+        case 0xB80:
+            name = "mcycleh";
+            break;
+        case 0xB82:
+            name = "minstreth";
+            break;
+
+        // Unprivileged Counter/Timers
+        case 0xC00:
+            name = "cycle";
+            break;
+        case 0xC01:
+            name = "time";
+            break;
+        case 0xC02:
+            name = "instret";
+            break;
+        case 0xC80:
+            name = "cycleh";
+            break;
+        case 0xC81:
+            name = "timeh";
+            break;
+        case 0xC82:
+            name = "instreth";
+            break;
+
         default:
             name = "unknown";
             break;
@@ -229,4 +266,294 @@ const char *RiscvEmulatorGetMcauseException(const uint8_t interrupt, const uint3
 
 #endif
 
+#if (RVE_E_HOOK == 1) || (RVE_E_HISTOGRAM == 1)
+/**
+ * Debug function for returning the name of the instruction of a hook context or histogram entry.
+ */
+const char *RiscvEmulatorGetHookInstructionName(const uint8_t instruction) {
+    switch (instruction) {
+        case HOOK_INSTRUCTION_ADD:
+            return "add";
+        case HOOK_INSTRUCTION_ADDI:
+            return "addi";
+        case HOOK_INSTRUCTION_AND:
+            return "and";
+        case HOOK_INSTRUCTION_ANDI:
+            return "andi";
+        case HOOK_INSTRUCTION_AUIPC:
+            return "auipc";
+        case HOOK_INSTRUCTION_BEQ:
+            return "beq";
+        case HOOK_INSTRUCTION_BGE:
+            return "bge";
+        case HOOK_INSTRUCTION_BGEU:
+            return "bgeu";
+        case HOOK_INSTRUCTION_BLT:
+            return "blt";
+        case HOOK_INSTRUCTION_BLTU:
+            return "bltu";
+        case HOOK_INSTRUCTION_BNE:
+            return "bne";
+        case HOOK_INSTRUCTION_EBREAK:
+            return "ebreak";
+        case HOOK_INSTRUCTION_ECALL:
+            return "ecall";
+        case HOOK_INSTRUCTION_FENCE:
+            return "fence";
+        case HOOK_INSTRUCTION_FENCEI:
+            return "fencei";
+        case HOOK_INSTRUCTION_JAL:
+            return "jal";
+        case HOOK_INSTRUCTION_JALR:
+            return "jalr";
+        case HOOK_INSTRUCTION_LB:
+            return "lb";
+        case HOOK_INSTRUCTION_LBU:
+            return "lbu";
+        case HOOK_INSTRUCTION_LH:
+            return "lh";
+        case HOOK_INSTRUCTION_LHU:
+            return "lhu";
+        case HOOK_INSTRUCTION_LUI:
+            return "lui";
+        case HOOK_INSTRUCTION_LW:
+            return "lw";
+        case HOOK_INSTRUCTION_OR:
+            return "or";
+        case HOOK_INSTRUCTION_ORI:
+            return "ori";
+        case HOOK_INSTRUCTION_SB:
+            return "sb";
+        case HOOK_INSTRUCTION_SH:
+            return "sh";
+        case HOOK_INSTRUCTION_SLL:
+            return "sll";
+        case HOOK_INSTRUCTION_SLLI:
+            return "slli";
+        case HOOK_INSTRUCTION_SLT:
+            return "slt";
+        case HOOK_INSTRUCTION_SLTI:
+            return "slti";
+        case HOOK_INSTRUCTION_SLTIU:
+            return "sltiu";
+        case HOOK_INSTRUCTION_SLTU:
+            return "sltu";
+        case HOOK_INSTRUCTION_SRA:
+            return "sra";
+        case HOOK_INSTRUCTION_SRAI:
+            return "srai";
+        case HOOK_INSTRUCTION_SRL:
+            return "srl";
+        case HOOK_INSTRUCTION_SRLI:
+            return "srli";
+        case HOOK_INSTRUCTION_SUB:
+            return "sub";
+        case HOOK_INSTRUCTION_SW:
+            return "sw";
+        case HOOK_INSTRUCTION_WFI:
+            return "wfi";
+        case HOOK_INSTRUCTION_XOR:
+            return "xor";
+        case HOOK_INSTRUCTION_XORI:
+            return "xori";
+        case HOOK_INSTRUCTION_DIV:
+            return "div";
+        case HOOK_INSTRUCTION_DIVU:
+            return "divu";
+        case HOOK_INSTRUCTION_MUL:
+            return "mul";
+        case HOOK_INSTRUCTION_MULH:
+            return "mulh";
+        case HOOK_INSTRUCTION_MULHSU:
+            return "mulhsu";
+        case HOOK_INSTRUCTION_MULHU:
+            return "mulhu";
+        case HOOK_INSTRUCTION_REM:
+            return "rem";
+        case HOOK_INSTRUCTION_REMU:
+            return "remu";
+        case HOOK_INSTRUCTION_C_ADD:
+            return "c.add";
+        case HOOK_INSTRUCTION_C_ADDI:
+            return "c.addi";
+        case HOOK_INSTRUCTION_C_ADDI16SP:
+            return "c.addi16sp";
+        case HOOK_INSTRUCTION_C_ADDI4SPN:
+            return "c.addi4spn";
+        case HOOK_INSTRUCTION_C_AND:
+            return "c.and";
+        case HOOK_INSTRUCTION_C_ANDI:
+            return "c.andi";
+        case HOOK_INSTRUCTION_C_BEQZ:
+            return "c.beqz";
+        case HOOK_INSTRUCTION_C_BNEZ:
+            return "c.bnez";
+        case HOOK_INSTRUCTION_C_EBREAK:
+            return "c.ebreak";
+        case HOOK_INSTRUCTION_C_J:
+            return "c.j";
+        case HOOK_INSTRUCTION_C_JAL:
+            return "c.jal";
+        case HOOK_INSTRUCTION_C_JALR:
+            return "c.jalr";
+        case HOOK_INSTRUCTION_C_JR:
+            return "c.jr";
+        case HOOK_INSTRUCTION_C_LI:
+            return "c.li";
+        case HOOK_INSTRUCTION_C_LUI:
+            return "c.lui";
+        case HOOK_INSTRUCTION_C_LW:
+            return "c.lw";
+        case HOOK_INSTRUCTION_C_LWSP:
+            return "c.lwsp";
+        case HOOK_INSTRUCTION_C_MV:
+            return "c.mv";
+        case HOOK_INSTRUCTION_C_OR:
+            return "c.or";
+        case HOOK_INSTRUCTION_C_SLLI:
+            return "c.slli";
+        case HOOK_INSTRUCTION_C_SRAI:
+            return "c.srai";
+        case HOOK_INSTRUCTION_C_SRLI:
+            return "c.srli";
+        case HOOK_INSTRUCTION_C_SUB:
+            return "c.sub";
+        case HOOK_INSTRUCTION_C_SW:
+            return "c.sw";
+        case HOOK_INSTRUCTION_C_SWSP:
+            return "c.swsp";
+        case HOOK_INSTRUCTION_C_XOR:
+            return "c.xor";
+        case HOOK_INSTRUCTION_CSRRC:
+            return "csrrc";
+        case HOOK_INSTRUCTION_CSRRCI:
+            return "csrrci";
+        case HOOK_INSTRUCTION_CSRRS:
+            return "csrrs";
+        case HOOK_INSTRUCTION_CSRRSI:
+            return "csrrsi";
+        case HOOK_INSTRUCTION_CSRRW:
+            return "csrrw";
+        case HOOK_INSTRUCTION_CSRRWI:
+            return "csrrwi";
+        case HOOK_INSTRUCTION_MRET:
+            return "mret";
+        case HOOK_INSTRUCTION_SH1ADD:
+            return "sh1add";
+        case HOOK_INSTRUCTION_SH2ADD:
+            return "sh2add";
+        case HOOK_INSTRUCTION_SH3ADD:
+            return "sh3add";
+        case HOOK_INSTRUCTION_ANDN:
+            return "andn";
+        case HOOK_INSTRUCTION_CLZ:
+            return "clz";
+        case HOOK_INSTRUCTION_CPOP:
+            return "cpop";
+        case HOOK_INSTRUCTION_CTZ:
+            return "ctz";
+        case HOOK_INSTRUCTION_MAX:
+            return "max";
+        case HOOK_INSTRUCTION_MAXU:
+            return "maxu";
+        case HOOK_INSTRUCTION_MIN:
+            return "min";
+        case HOOK_INSTRUCTION_MINU:
+            return "minu";
+        case HOOK_INSTRUCTION_ORC_B:
+            return "orc.b";
+        case HOOK_INSTRUCTION_ORN:
+            return "orn";
+        case HOOK_INSTRUCTION_REV8:
+            return "rev8";
+        case HOOK_INSTRUCTION_ROL:
+            return "rol";
+        case HOOK_INSTRUCTION_ROR:
+            return "ror";
+        case HOOK_INSTRUCTION_RORI:
+            return "rori";
+        case HOOK_INSTRUCTION_SEXT_B:
+            return "sext.b";
+        case HOOK_INSTRUCTION_SEXT_H:
+            return "sext.h";
+        case HOOK_INSTRUCTION_XNOR:
+            return "xnor";
+        case HOOK_INSTRUCTION_ZEXT_H:
+            return "zext.h";
+        case HOOK_INSTRUCTION_CLMUL:
+            return "clmul";
+        case HOOK_INSTRUCTION_CLMULH:
+            return "clmulh";
+        case HOOK_INSTRUCTION_CLMULR:
+            return "clmulr";
+        case HOOK_INSTRUCTION_BCLR:
+            return "bclr";
+        case HOOK_INSTRUCTION_BCLRI:
+            return "bclri";
+        case HOOK_INSTRUCTION_BEXT:
+            return "bext";
+        case HOOK_INSTRUCTION_BEXTI:
+            return "bexti";
+        case HOOK_INSTRUCTION_BINV:
+            return "binv";
+        case HOOK_INSTRUCTION_BINVI:
+            return "binvi";
+        case HOOK_INSTRUCTION_BSET:
+            return "bset";
+        case HOOK_INSTRUCTION_BSETI:
+            return "bseti";
+        case HOOK_INSTRUCTION_TRAP:
+            return "_trap";
+        case HOOK_INSTRUCTION_INTERRUPT:
+            return "_interrupt";
+        case HOOK_INSTRUCTION_LR_W:
+            return "lr.w";
+        case HOOK_INSTRUCTION_SC_W:
+            return "sc.w";
+        case HOOK_INSTRUCTION_AMOADD_W:
+            return "amoadd.w";
+        case HOOK_INSTRUCTION_AMOAND_W:
+            return "amoand.w";
+        case HOOK_INSTRUCTION_AMOMAX_W:
+            return "amomax.w";
+        case HOOK_INSTRUCTION_AMOMAXU_W:
+            return "amomaxu.w";
+        case HOOK_INSTRUCTION_AMOMIN_W:
+            return "amomin.w";
+        case HOOK_INSTRUCTION_AMOMINU_W:
+            return "amominu.w";
+        case HOOK_INSTRUCTION_AMOOR_W:
+            return "amoor.w";
+        case HOOK_INSTRUCTION_AMOSWAP_W:
+            return "amoswap.w";
+        case HOOK_INSTRUCTION_AMOXOR_W:
+            return "amoxor.w";
+        default:
+            return "unknown";
+    }
+}
+#endif
+
+#if (RVE_E_HOOK == 1)
+/**
+ * Debug function for returning the name of the immediate of a hook context.
+ */
+const char *RiscvEmulatorGetHookImmediateName(const uint8_t immname) {
+    switch (immname) {
+        case HOOK_IMMEDIATE_NZIMM:
+            return "nzimm";
+        case HOOK_IMMEDIATE_NZUIMM:
+            return "nzuimm";
+        case HOOK_IMMEDIATE_OFFSET:
+            return "offset";
+        case HOOK_IMMEDIATE_SHAMT:
+            return "shamt";
+        case HOOK_IMMEDIATE_UIMM:
+            return "uimm";
+        default:
+            return "imm";
+    }
+}
+#endif
+
 #endif
\ No newline at end of file
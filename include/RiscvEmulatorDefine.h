@@ -22,12 +22,21 @@
 #define RAM_ORIGIN  0x80000000
 
 #include "RiscvEmulatorDefineBType.h"
+#include "RiscvEmulatorDefineCache.h"
 #include "RiscvEmulatorDefineCSRMachineTrapHandling.h"
+#include "RiscvEmulatorDefineClint.h"
 #include "RiscvEmulatorDefineCType.h"
+#include "RiscvEmulatorDefineEvent.h"
+#include "RiscvEmulatorDefineExit.h"
+#include "RiscvEmulatorDefineHeatmap.h"
 #include "RiscvEmulatorDefineHook.h"
 #include "RiscvEmulatorDefineIType.h"
 #include "RiscvEmulatorDefineOpcode.h"
+#include "RiscvEmulatorDefinePending.h"
+#include "RiscvEmulatorDefinePredictor.h"
+#include "RiscvEmulatorDefineProfile.h"
 #include "RiscvEmulatorDefineRType.h"
 #include "RiscvEmulatorDefineSType.h"
+#include "RiscvEmulatorDefineTrace.h"
 
 #endif
\ No newline at end of file
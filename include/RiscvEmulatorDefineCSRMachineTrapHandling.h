@@ -29,6 +29,18 @@
 #define MCAUSE_EXCEPTION_CODE_SOFTWARE_CHECK                 18
 #define MCAUSE_EXCEPTION_CODE_HARDWARE_ERROR                 19
 
+// Machine cause interrupt code, in order of priority.
+
+#define MCAUSE_INTERRUPT_CODE_MACHINE_EXTERNAL 11
+#define MCAUSE_INTERRUPT_CODE_MACHINE_SOFTWARE 3
+#define MCAUSE_INTERRUPT_CODE_MACHINE_TIMER    7
+
+// Machine interrupt pending and enable bits.
+
+#define MIP_MSIP 0x00000008
+#define MIP_MTIP 0x00000080
+#define MIP_MEIP 0x00000800
+
 #endif
 
 #endif
\ No newline at end of file
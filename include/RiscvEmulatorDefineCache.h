@@ -0,0 +1,17 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorDefineCache_H_
+#define RiscvEmulatorDefineCache_H_
+
+// Replacement policies of a simulated cache.
+
+#define CACHE_POLICY_LRU    0
+#define CACHE_POLICY_FIFO   1
+#define CACHE_POLICY_RANDOM 2
+
+#endif
@@ -0,0 +1,23 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorDefineClint_H_
+#define RiscvEmulatorDefineClint_H_
+
+#if (RVE_E_CLINT == 1)
+// Core-local interruptor, memory mapped registers relative to CLINT_ORIGIN.
+
+#define CLINT_ORIGIN IO_ORIGIN
+#define CLINT_LENGTH 0x10000
+
+#define CLINT_MSIP     0x0000
+#define CLINT_MTIMECMP 0x4000
+#define CLINT_MTIME    0xBFF8
+
+#endif
+
+#endif
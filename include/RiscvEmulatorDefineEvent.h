@@ -0,0 +1,23 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorDefineEvent_H_
+#define RiscvEmulatorDefineEvent_H_
+
+// Events counted by the emulator, selectable in mhpmevent3..31.
+
+#define EVENT_NONE           0
+#define EVENT_LOAD           1
+#define EVENT_STORE          2
+#define EVENT_BRANCH_TAKEN   3
+#define EVENT_COMPRESSED     4
+#define EVENT_ATOMIC         5
+#define EVENT_TRAP           6
+
+#define EVENT_COUNT 7
+
+#endif
@@ -0,0 +1,28 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorDefineExit_H_
+#define RiscvEmulatorDefineExit_H_
+
+// Reasons for RiscvEmulatorRun() to stop.
+
+#define EXIT_REASON_NONE  0
+#define EXIT_REASON_EXIT  1
+#define EXIT_REASON_ERROR 2
+#define EXIT_REASON_LIMIT 3
+
+// Waiting for I/O, see RiscvEmulatorResume().
+#define EXIT_REASON_PENDING 4
+
+// Waiting for an interrupt or device nothing inside the emulator will change, see RiscvEmulatorSetInterruptPending()
+// and RiscvEmulatorWake().
+#define EXIT_REASON_WFI 5
+
+// First reason free for the implementation.
+#define EXIT_REASON_USER 16
+
+#endif
@@ -0,0 +1,14 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorDefineHeatmap_H_
+#define RiscvEmulatorDefineHeatmap_H_
+
+// Longest line written by RiscvEmulatorHeatmapRow(): address, 2 counts of 20 digits, separators and terminating 0.
+#define HEATMAP_ROW_LENGTH 53
+
+#endif
@@ -8,8 +8,186 @@
 #ifndef RiscvEmulatorDefineHook_H_
 #define RiscvEmulatorDefineHook_H_
 
-#define HOOK_UNKNOWN 0
-#define HOOK_BEGIN   1
-#define HOOK_END     2
+// Hook context hook.
 
-#endif
\ No newline at end of file
+#define HOOK_UNKNOWN   0
+#define HOOK_BEGIN     1
+#define HOOK_END       2
+#define HOOK_TRAP      3
+#define HOOK_INTERRUPT 4
+
+// Bits of state->hookmask, one per hook.
+
+#define HOOK_MASK_BEGIN       (1 << HOOK_BEGIN)
+#define HOOK_MASK_END         (1 << HOOK_END)
+#define HOOK_MASK_TRAP        (1 << HOOK_TRAP)
+#define HOOK_MASK_INTERRUPT   (1 << HOOK_INTERRUPT)
+#define HOOK_MASK_INSTRUCTION (HOOK_MASK_BEGIN | HOOK_MASK_END)
+#define HOOK_MASK_ALL         (HOOK_MASK_INSTRUCTION | HOOK_MASK_TRAP | HOOK_MASK_INTERRUPT)
+
+// Hook context instruction, see RiscvEmulatorGetHookInstructionName().
+
+// Not an instruction.
+#define HOOK_INSTRUCTION_UNKNOWN    0
+
+// RV32I.
+#define HOOK_INSTRUCTION_ADD        1
+#define HOOK_INSTRUCTION_ADDI       2
+#define HOOK_INSTRUCTION_AND        3
+#define HOOK_INSTRUCTION_ANDI       4
+#define HOOK_INSTRUCTION_AUIPC      5
+#define HOOK_INSTRUCTION_BEQ        6
+#define HOOK_INSTRUCTION_BGE        7
+#define HOOK_INSTRUCTION_BGEU       8
+#define HOOK_INSTRUCTION_BLT        9
+#define HOOK_INSTRUCTION_BLTU       10
+#define HOOK_INSTRUCTION_BNE        11
+#define HOOK_INSTRUCTION_EBREAK     12
+#define HOOK_INSTRUCTION_ECALL      13
+#define HOOK_INSTRUCTION_FENCE      14
+#define HOOK_INSTRUCTION_FENCEI     15
+#define HOOK_INSTRUCTION_JAL        16
+#define HOOK_INSTRUCTION_JALR       17
+#define HOOK_INSTRUCTION_LB         18
+#define HOOK_INSTRUCTION_LBU        19
+#define HOOK_INSTRUCTION_LH         20
+#define HOOK_INSTRUCTION_LHU        21
+#define HOOK_INSTRUCTION_LUI        22
+#define HOOK_INSTRUCTION_LW         23
+#define HOOK_INSTRUCTION_OR         24
+#define HOOK_INSTRUCTION_ORI        25
+#define HOOK_INSTRUCTION_SB         26
+#define HOOK_INSTRUCTION_SH         27
+#define HOOK_INSTRUCTION_SLL        28
+#define HOOK_INSTRUCTION_SLLI       29
+#define HOOK_INSTRUCTION_SLT        30
+#define HOOK_INSTRUCTION_SLTI       31
+#define HOOK_INSTRUCTION_SLTIU      32
+#define HOOK_INSTRUCTION_SLTU       33
+#define HOOK_INSTRUCTION_SRA        34
+#define HOOK_INSTRUCTION_SRAI       35
+#define HOOK_INSTRUCTION_SRL        36
+#define HOOK_INSTRUCTION_SRLI       37
+#define HOOK_INSTRUCTION_SUB        38
+#define HOOK_INSTRUCTION_SW         39
+#define HOOK_INSTRUCTION_WFI        40
+#define HOOK_INSTRUCTION_XOR        41
+#define HOOK_INSTRUCTION_XORI       42
+
+// M extension.
+#define HOOK_INSTRUCTION_DIV        43
+#define HOOK_INSTRUCTION_DIVU       44
+#define HOOK_INSTRUCTION_MUL        45
+#define HOOK_INSTRUCTION_MULH       46
+#define HOOK_INSTRUCTION_MULHSU     47
+#define HOOK_INSTRUCTION_MULHU      48
+#define HOOK_INSTRUCTION_REM        49
+#define HOOK_INSTRUCTION_REMU       50
+
+// C extension.
+#define HOOK_INSTRUCTION_C_ADD      51
+#define HOOK_INSTRUCTION_C_ADDI     52
+#define HOOK_INSTRUCTION_C_ADDI16SP 53
+#define HOOK_INSTRUCTION_C_ADDI4SPN 54
+#define HOOK_INSTRUCTION_C_AND      55
+#define HOOK_INSTRUCTION_C_ANDI     56
+#define HOOK_INSTRUCTION_C_BEQZ     57
+#define HOOK_INSTRUCTION_C_BNEZ     58
+#define HOOK_INSTRUCTION_C_EBREAK   59
+#define HOOK_INSTRUCTION_C_J        60
+#define HOOK_INSTRUCTION_C_JAL      61
+#define HOOK_INSTRUCTION_C_JALR     62
+#define HOOK_INSTRUCTION_C_JR       63
+#define HOOK_INSTRUCTION_C_LI       64
+#define HOOK_INSTRUCTION_C_LUI      65
+#define HOOK_INSTRUCTION_C_LW       66
+#define HOOK_INSTRUCTION_C_LWSP     67
+#define HOOK_INSTRUCTION_C_MV       68
+#define HOOK_INSTRUCTION_C_OR       69
+#define HOOK_INSTRUCTION_C_SLLI     70
+#define HOOK_INSTRUCTION_C_SRAI     71
+#define HOOK_INSTRUCTION_C_SRLI     72
+#define HOOK_INSTRUCTION_C_SUB      73
+#define HOOK_INSTRUCTION_C_SW       74
+#define HOOK_INSTRUCTION_C_SWSP     75
+#define HOOK_INSTRUCTION_C_XOR      76
+
+// Zicsr extension.
+#define HOOK_INSTRUCTION_CSRRC      77
+#define HOOK_INSTRUCTION_CSRRCI     78
+#define HOOK_INSTRUCTION_CSRRS      79
+#define HOOK_INSTRUCTION_CSRRSI     80
+#define HOOK_INSTRUCTION_CSRRW      81
+#define HOOK_INSTRUCTION_CSRRWI     82
+#define HOOK_INSTRUCTION_MRET       83
+
+// Zba extension.
+#define HOOK_INSTRUCTION_SH1ADD     84
+#define HOOK_INSTRUCTION_SH2ADD     85
+#define HOOK_INSTRUCTION_SH3ADD     86
+
+// Zbb extension.
+#define HOOK_INSTRUCTION_ANDN       87
+#define HOOK_INSTRUCTION_CLZ        88
+#define HOOK_INSTRUCTION_CPOP       89
+#define HOOK_INSTRUCTION_CTZ        90
+#define HOOK_INSTRUCTION_MAX        91
+#define HOOK_INSTRUCTION_MAXU       92
+#define HOOK_INSTRUCTION_MIN        93
+#define HOOK_INSTRUCTION_MINU       94
+#define HOOK_INSTRUCTION_ORC_B      95
+#define HOOK_INSTRUCTION_ORN        96
+#define HOOK_INSTRUCTION_REV8       97
+#define HOOK_INSTRUCTION_ROL        98
+#define HOOK_INSTRUCTION_ROR        99
+#define HOOK_INSTRUCTION_RORI       100
+#define HOOK_INSTRUCTION_SEXT_B     101
+#define HOOK_INSTRUCTION_SEXT_H     102
+#define HOOK_INSTRUCTION_XNOR       103
+#define HOOK_INSTRUCTION_ZEXT_H     104
+
+// Zbc extension.
+#define HOOK_INSTRUCTION_CLMUL      105
+#define HOOK_INSTRUCTION_CLMULH     106
+#define HOOK_INSTRUCTION_CLMULR     107
+
+// Zbs extension.
+#define HOOK_INSTRUCTION_BCLR       108
+#define HOOK_INSTRUCTION_BCLRI      109
+#define HOOK_INSTRUCTION_BEXT       110
+#define HOOK_INSTRUCTION_BEXTI      111
+#define HOOK_INSTRUCTION_BINV       112
+#define HOOK_INSTRUCTION_BINVI      113
+#define HOOK_INSTRUCTION_BSET       114
+#define HOOK_INSTRUCTION_BSETI      115
+
+// Trap and interrupt hooks.
+#define HOOK_INSTRUCTION_TRAP       116
+#define HOOK_INSTRUCTION_INTERRUPT  117
+
+// Without hooks, only counted by the histogram.
+#define HOOK_INSTRUCTION_LR_W       118
+#define HOOK_INSTRUCTION_SC_W       119
+#define HOOK_INSTRUCTION_AMOADD_W   120
+#define HOOK_INSTRUCTION_AMOAND_W   121
+#define HOOK_INSTRUCTION_AMOMAX_W   122
+#define HOOK_INSTRUCTION_AMOMAXU_W  123
+#define HOOK_INSTRUCTION_AMOMIN_W   124
+#define HOOK_INSTRUCTION_AMOMINU_W  125
+#define HOOK_INSTRUCTION_AMOOR_W    126
+#define HOOK_INSTRUCTION_AMOSWAP_W  127
+#define HOOK_INSTRUCTION_AMOXOR_W   128
+
+// Number of hook context instructions.
+#define HOOK_INSTRUCTION_COUNT      129
+
+// Hook context immname, see RiscvEmulatorGetHookImmediateName().
+
+#define HOOK_IMMEDIATE_NONE   0
+#define HOOK_IMMEDIATE_NZIMM  1
+#define HOOK_IMMEDIATE_NZUIMM 2
+#define HOOK_IMMEDIATE_OFFSET 3
+#define HOOK_IMMEDIATE_SHAMT  4
+#define HOOK_IMMEDIATE_UIMM   5
+
+#endif
@@ -0,0 +1,20 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorDefinePending_H_
+#define RiscvEmulatorDefinePending_H_
+
+// Kinds of pending I/O, see RiscvEmulatorSuspend().
+
+#define PENDING_NONE      0
+#define PENDING_SUSPENDED 1
+#define PENDING_LOAD      2
+#define PENDING_STORE     3
+#define PENDING_ECALL     4
+#define PENDING_COMPLETED 5
+
+#endif
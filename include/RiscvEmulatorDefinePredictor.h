@@ -0,0 +1,19 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorDefinePredictor_H_
+#define RiscvEmulatorDefinePredictor_H_
+
+// Direction predictors of a simulated branch predictor.
+
+// 2-bit counters indexed by the program counter.
+#define PREDICTOR_BIMODAL 0
+
+// 2-bit counters indexed by the program counter and the outcome of the previous branches.
+#define PREDICTOR_GSHARE 1
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorDefineProfile_H_
+#define RiscvEmulatorDefineProfile_H_
+
+// ELF32 fields read to find the function symbols.
+
+#define PROFILE_ELF_HEADER_LENGTH  52
+#define PROFILE_ELF_SECTION_LENGTH 40
+#define PROFILE_ELF_SYMBOL_LENGTH  16
+#define PROFILE_ELF_CLASS32        1
+#define PROFILE_ELF_DATA2LSB       1
+#define PROFILE_ELF_SHT_SYMTAB     2
+#define PROFILE_ELF_STT_FUNC       2
+
+// Node of the call tree no call was seen for.
+#define PROFILE_NODE_ROOT 0
+
+// Returned when the call tree is full.
+#define PROFILE_NODE_NONE UINT32_MAX
+
+#endif
@@ -0,0 +1,37 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorDefineTrace_H_
+#define RiscvEmulatorDefineTrace_H_
+
+// Data memory access of a trace record.
+
+#define TRACE_MEMORY_NONE  0
+#define TRACE_MEMORY_LOAD  1
+#define TRACE_MEMORY_STORE 2
+
+// First byte of an encoded trace record, see RiscvEmulatorTraceCodec.h.
+
+#define TRACE_CODEC_JUMP          0x01
+#define TRACE_CODEC_DICTIONARY    0x02
+#define TRACE_CODEC_RD            0x04
+#define TRACE_CODEC_MEMORY_SHIFT  3
+#define TRACE_CODEC_MEMORY_MASK   0x03
+#define TRACE_CODEC_LENGTH_SHIFT  5
+#define TRACE_CODEC_LENGTH_MASK   0x03
+#define TRACE_CODEC_MEMORYRDVALUE 0x80
+
+// Memory access 3 marks a seek point.
+#define TRACE_CODEC_SEEK 0x18
+
+// Number of instructions in the dictionary, indexed by program counter, must be a power of 2.
+#define TRACE_CODEC_DICTIONARY_LENGTH 4096
+
+// Maximum number of bytes of an encoded trace record, including a seek point.
+#define TRACE_CODEC_LENGTH 32
+
+#endif
@@ -0,0 +1,39 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorEvent_H_
+#define RiscvEmulatorEvent_H_
+
+#include <stdint.h>
+
+#include "RiscvEmulatorConfig.h"
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * Count an event of the instruction being executed.
+ *
+ * Compiles to nothing when no feature counts events. Every event is counted exactly once, so
+ * RiscvEmulatorLockstepRun() leaves all instructions to the regular emulator when events are counted.
+ *
+ * @param event One of EVENT_*.
+ */
+static inline void RiscvEmulatorEvent(RiscvEmulatorState_t *state __attribute__((unused)), const uint8_t event __attribute__((unused))) {
+#if (RVE_E_ZIHPM == 1)
+#if (RVE_E_ASYNC == 1)
+    // Counted when the instruction suspended, not again when it is executed again after RiscvEmulatorResume().
+    if (state->pending.kind == PENDING_COMPLETED) {
+        return;
+    }
+#endif
+
+    state->eventcount[event]++;
+#endif
+}
+
+#endif
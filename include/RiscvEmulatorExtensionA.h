@@ -14,9 +14,11 @@
 
 #include <stdint.h>
 
-#include <RiscvEmulatorImplementationSpecific.h>
+#include "RiscvEmulatorOps.h"
 
+#include "RiscvEmulatorAtomic.h"
 #include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorHistogram.h"
 #include "RiscvEmulatorType.h"
 
 #include "RiscvEmulatorExtensionI.h"
@@ -119,6 +121,255 @@ static inline void RiscvEmulatorAMOMAXU_W(
     }
 }
 
+/**
+ * Load word and register a reservation on its address.
+ */
+static inline void RiscvEmulatorLR_W(
+    RiscvEmulatorState_t *state,
+    const uint8_t rdnum,
+    void *rd,
+    const uint32_t address,
+    const uint8_t aq __attribute__((unused)),
+    const uint8_t rl __attribute__((unused))) {
+
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_LR_W);
+
+#if (RVE_E_ZICSR == 1)
+    if ((address & 0b11) != 0) {
+        state->trapflag.loadaddressmisaligned = 1;
+        state->csr.mtval = address;
+        return;
+    }
+#endif
+
+    uint32_t loadedvalue = 0;
+#if (RVE_E_SMP == 1)
+    uint32_t *hostaddress = RiscvEmulatorAtomicHostAddress(state, address);
+    if (hostaddress != 0) {
+        RiscvEmulatorAtomicReleaseFence(aq, rl);
+        loadedvalue = __atomic_load_n(hostaddress, __ATOMIC_RELAXED);
+        RiscvEmulatorAtomicAcquireFence(aq, rl);
+        RiscvEmulatorOpsObserve(state, TRACE_MEMORY_LOAD, address, &loadedvalue, sizeof(uint32_t));
+    } else {
+        RiscvEmulatorOpsLoad(state, address, &loadedvalue, sizeof(uint32_t));
+    }
+#else
+    RiscvEmulatorOpsLoad(state, address, &loadedvalue, sizeof(uint32_t));
+#endif
+
+#if (RVE_E_ASYNC == 1)
+    // The load is executed again when resumed.
+    if (state->pending.kind == PENDING_LOAD) {
+        return;
+    }
+#endif
+
+    state->reservationaddress = address;
+    state->reservationvalid = 1;
+#if (RVE_E_SMP == 1)
+    state->reservationvalue = loadedvalue;
+#endif
+
+    if (rdnum != 0) {
+        *(uint32_t *)rd = loadedvalue;
+    }
+}
+
+/**
+ * Store word when the reservation is still valid. rd = 0 on success, 1 on failure.
+ *
+ * With a single hart nothing else can write memory, so a valid reservation on the same address always succeeds.
+ * With multiple harts the value loaded by LR.W is compared with the current value. For RAM this is a host
+ * compare-and-swap, otherwise it happens while holding the lock of the cache line, so only SC.W and AMOs on cache
+ * lines sharing that lock contend.
+ */
+static inline void RiscvEmulatorSC_W(
+    RiscvEmulatorState_t *state,
+    const uint8_t rdnum,
+    void *rd,
+    const uint32_t address,
+    const uint32_t value,
+    const uint8_t aq __attribute__((unused)),
+    const uint8_t rl __attribute__((unused))) {
+
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SC_W);
+
+#if (RVE_E_ZICSR == 1)
+    if ((address & 0b11) != 0) {
+        state->trapflag.storeaddressmisaligned = 1;
+        state->csr.mtval = address;
+        return;
+    }
+#endif
+
+    uint32_t result = 1;
+
+    if (state->reservationvalid == 1 &&
+        state->reservationaddress == address) {
+#if (RVE_E_SMP == 1)
+        uint32_t *hostaddress = RiscvEmulatorAtomicHostAddress(state, address);
+        if (hostaddress != 0) {
+            uint32_t expectedvalue = state->reservationvalue;
+            RiscvEmulatorAtomicReleaseFence(aq, rl);
+            if (__atomic_compare_exchange_n(hostaddress, &expectedvalue, value, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                result = 0;
+            }
+            RiscvEmulatorAtomicAcquireFence(aq, rl);
+
+            // Like the locked path, the current value is loaded and only stored to when it did not change.
+            RiscvEmulatorOpsObserve(state, TRACE_MEMORY_LOAD, address, &expectedvalue, sizeof(uint32_t));
+            if (result == 0) {
+                RiscvEmulatorOpsObserve(state, TRACE_MEMORY_STORE, address, &value, sizeof(uint32_t));
+            }
+        } else {
+            RiscvEmulatorAtomicLock(address);
+
+            uint32_t currentvalue = 0;
+            RiscvEmulatorOpsLoad(state, address, &currentvalue, sizeof(uint32_t));
+
+#if (RVE_E_ASYNC == 1)
+            if (state->pending.kind == PENDING_LOAD) {
+                RiscvEmulatorAtomicUnlock(address);
+                return;
+            }
+#endif
+
+            if (currentvalue == state->reservationvalue) {
+                RiscvEmulatorOpsStore(state, address, &value, sizeof(uint32_t));
+                result = 0;
+            }
+
+            RiscvEmulatorAtomicUnlock(address);
+        }
+#else
+        RiscvEmulatorOpsStore(state, address, &value, sizeof(uint32_t));
+        result = 0;
+#endif
+    }
+
+    // A store-conditional always invalidates the reservation.
+    state->reservationvalid = 0;
+
+    if (rdnum != 0) {
+        *(uint32_t *)rd = result;
+    }
+}
+
+#if (RVE_E_SMP == 1)
+/**
+ * Execute an atomic memory operation directly on host RAM using host atomics.
+ *
+ * Memory ordering of the aq and rl bits is provided by fences around the operation.
+ */
+static inline void RiscvEmulatorAMOHost(
+    RiscvEmulatorState_t *state,
+    const uint8_t rdnum,
+    void *rd,
+    const uint32_t address,
+    uint32_t *hostaddress,
+    const uint32_t value,
+    const uint16_t funct5_3,
+    const uint8_t aq,
+    const uint8_t rl) {
+
+    uint32_t loadedvalue = 0;
+    uint32_t newvalue = 0;
+
+    RiscvEmulatorAtomicReleaseFence(aq, rl);
+
+    switch (funct5_3) {
+        case FUNCT5_FUNCT3_OPERATION_AMOADD_W:
+            loadedvalue = __atomic_fetch_add(hostaddress, value, __ATOMIC_RELAXED);
+            newvalue = loadedvalue + value;
+            break;
+        case FUNCT5_FUNCT3_OPERATION_AMOSWAP_W:
+            loadedvalue = __atomic_exchange_n(hostaddress, value, __ATOMIC_RELAXED);
+            newvalue = value;
+            break;
+        case FUNCT5_FUNCT3_OPERATION_AMOXOR_W:
+            loadedvalue = __atomic_fetch_xor(hostaddress, value, __ATOMIC_RELAXED);
+            newvalue = loadedvalue ^ value;
+            break;
+        case FUNCT5_FUNCT3_OPERATION_AMOOR_W:
+            loadedvalue = __atomic_fetch_or(hostaddress, value, __ATOMIC_RELAXED);
+            newvalue = loadedvalue | value;
+            break;
+        case FUNCT5_FUNCT3_OPERATION_AMOAND_W:
+            loadedvalue = __atomic_fetch_and(hostaddress, value, __ATOMIC_RELAXED);
+            newvalue = loadedvalue & value;
+            break;
+        case FUNCT5_FUNCT3_OPERATION_AMOMIN_W:
+        case FUNCT5_FUNCT3_OPERATION_AMOMAX_W:
+        case FUNCT5_FUNCT3_OPERATION_AMOMINU_W:
+        case FUNCT5_FUNCT3_OPERATION_AMOMAXU_W: {
+            // There are no host atomics for minimum and maximum, retry until no other hart changed memory.
+            loadedvalue = __atomic_load_n(hostaddress, __ATOMIC_RELAXED);
+            do {
+                newvalue = loadedvalue;
+                switch (funct5_3) {
+                    case FUNCT5_FUNCT3_OPERATION_AMOMIN_W:
+                        RiscvEmulatorAMOMIN_W(state, &newvalue, &value);
+                        break;
+                    case FUNCT5_FUNCT3_OPERATION_AMOMAX_W:
+                        RiscvEmulatorAMOMAX_W(state, &newvalue, &value);
+                        break;
+                    case FUNCT5_FUNCT3_OPERATION_AMOMINU_W:
+                        RiscvEmulatorAMOMINU_W(state, &newvalue, &value);
+                        break;
+                    case FUNCT5_FUNCT3_OPERATION_AMOMAXU_W:
+                        RiscvEmulatorAMOMAXU_W(state, &newvalue, &value);
+                        break;
+                }
+            } while (!__atomic_compare_exchange_n(hostaddress, &loadedvalue, newvalue, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+            break;
+        }
+        default:
+            state->trapflag.illegalinstruction = 1;
+            return;
+    }
+
+    RiscvEmulatorAtomicAcquireFence(aq, rl);
+
+    // Seen like the load and store of the locked path.
+    RiscvEmulatorOpsObserve(state, TRACE_MEMORY_LOAD, address, &loadedvalue, sizeof(uint32_t));
+    RiscvEmulatorOpsObserve(state, TRACE_MEMORY_STORE, address, &newvalue, sizeof(uint32_t));
+
+    if (rdnum != 0) {
+        *(uint32_t *)rd = loadedvalue;
+    }
+}
+#endif
+
+#if (RVE_E_HISTOGRAM == 1)
+/**
+ * Returns the HOOK_INSTRUCTION_* number of an atomic memory operation.
+ */
+static inline uint8_t RiscvEmulatorAMOInstruction(const uint16_t funct5_3) {
+    switch (funct5_3) {
+        case FUNCT5_FUNCT3_OPERATION_AMOADD_W:
+            return HOOK_INSTRUCTION_AMOADD_W;
+        case FUNCT5_FUNCT3_OPERATION_AMOAND_W:
+            return HOOK_INSTRUCTION_AMOAND_W;
+        case FUNCT5_FUNCT3_OPERATION_AMOMAX_W:
+            return HOOK_INSTRUCTION_AMOMAX_W;
+        case FUNCT5_FUNCT3_OPERATION_AMOMAXU_W:
+            return HOOK_INSTRUCTION_AMOMAXU_W;
+        case FUNCT5_FUNCT3_OPERATION_AMOMIN_W:
+            return HOOK_INSTRUCTION_AMOMIN_W;
+        case FUNCT5_FUNCT3_OPERATION_AMOMINU_W:
+            return HOOK_INSTRUCTION_AMOMINU_W;
+        case FUNCT5_FUNCT3_OPERATION_AMOOR_W:
+            return HOOK_INSTRUCTION_AMOOR_W;
+        case FUNCT5_FUNCT3_OPERATION_AMOSWAP_W:
+            return HOOK_INSTRUCTION_AMOSWAP_W;
+        case FUNCT5_FUNCT3_OPERATION_AMOXOR_W:
+            return HOOK_INSTRUCTION_AMOXOR_W;
+        default:
+            return HOOK_INSTRUCTION_UNKNOWN;
+    }
+}
+#endif
+
 /**
  * Process atomic memory operation opcodes.
  */
@@ -137,18 +388,63 @@ static inline void RiscvEmulatorOpcodeAtomicMemoryOperation(
     // Remember original value stored in rs2.
     uint32_t originalvaluers2 = *(uint32_t *)rs2;
 
+    uint8_t aq = state->instruction.rtypeatomicmemoryoperation.aq;
+    uint8_t rl = state->instruction.rtypeatomicmemoryoperation.rl;
+
+    RiscvInstructionTypeRDecoderFunct5Funct3_u instruction_decoderhelper_rtypeatomicmemoryoperation = {0};
+    instruction_decoderhelper_rtypeatomicmemoryoperation.funct3 = state->instruction.rtypeatomicmemoryoperation.funct3;
+    instruction_decoderhelper_rtypeatomicmemoryoperation.funct5 = state->instruction.rtypeatomicmemoryoperation.funct5;
+
+    // Load-reserved and store-conditional do not modify memory in place.
+    switch (instruction_decoderhelper_rtypeatomicmemoryoperation.funct5_3) {
+        case FUNCT5_FUNCT3_OPERATION_LR_W:
+            if (rs2num == 0) {
+                RiscvEmulatorLR_W(state, rdnum, rd, originaladdressrs1, aq, rl);
+            } else {
+                state->trapflag.illegalinstruction = 1;
+            }
+            return;
+        case FUNCT5_FUNCT3_OPERATION_SC_W:
+            RiscvEmulatorSC_W(state, rdnum, rd, originaladdressrs1, originalvaluers2, aq, rl);
+            return;
+    }
+
+#if (RVE_E_HISTOGRAM == 1)
+    uint8_t hookinstruction = RiscvEmulatorAMOInstruction(instruction_decoderhelper_rtypeatomicmemoryoperation.funct5_3);
+    if (hookinstruction != HOOK_INSTRUCTION_UNKNOWN) {
+        RiscvEmulatorHistogram(state, hookinstruction);
+    }
+#endif
+
+#if (RVE_E_SMP == 1)
+    // RAM is modified in place with host atomics.
+    uint32_t *hostaddress = RiscvEmulatorAtomicHostAddress(state, originaladdressrs1);
+    if (hostaddress != 0) {
+        RiscvEmulatorAMOHost(state, rdnum, rd, originaladdressrs1, hostaddress, originalvaluers2, instruction_decoderhelper_rtypeatomicmemoryoperation.funct5_3, aq, rl);
+        return;
+    }
+
+    // No other hart may execute an atomic memory operation between the load and the store.
+    RiscvEmulatorAtomicLock(originaladdressrs1);
+#endif
+
     uint32_t loadedvalue = 0;
-    RiscvEmulatorLoad(originaladdressrs1, &loadedvalue, sizeof(uint32_t));
+    RiscvEmulatorOpsLoad(state, originaladdressrs1, &loadedvalue, sizeof(uint32_t));
+
+#if (RVE_E_ASYNC == 1)
+    if (state->pending.kind == PENDING_LOAD) {
+#if (RVE_E_SMP == 1)
+        RiscvEmulatorAtomicUnlock(originaladdressrs1);
+#endif
+        return;
+    }
+#endif
 
     if (rdnum != 0) {
         // Place loaded value of original address in rd.
         *(uint32_t *)rd = loadedvalue;
     }
 
-    RiscvInstructionTypeRDecoderFunct5Funct3_u instruction_decoderhelper_rtypeatomicmemoryoperation = {0};
-    instruction_decoderhelper_rtypeatomicmemoryoperation.funct3 = state->instruction.rtypeatomicmemoryoperation.funct3;
-    instruction_decoderhelper_rtypeatomicmemoryoperation.funct5 = state->instruction.rtypeatomicmemoryoperation.funct5;
-
     switch (instruction_decoderhelper_rtypeatomicmemoryoperation.funct5_3) {
         case FUNCT5_FUNCT3_OPERATION_AMOADD_W:
             RiscvEmulatorAMOADD_W(state, &loadedvalue, &originalvaluers2);
@@ -178,11 +474,18 @@ static inline void RiscvEmulatorOpcodeAtomicMemoryOperation(
             RiscvEmulatorAMOMAXU_W(state, &loadedvalue, &originalvaluers2);
             break;
         default:
+#if (RVE_E_SMP == 1)
+            RiscvEmulatorAtomicUnlock(originaladdressrs1);
+#endif
             state->trapflag.illegalinstruction = 1;
             return;
     }
 
-    RiscvEmulatorStore(originaladdressrs1, &loadedvalue, sizeof(uint32_t));
+    RiscvEmulatorOpsStore(state, originaladdressrs1, &loadedvalue, sizeof(uint32_t));
+
+#if (RVE_E_SMP == 1)
+    RiscvEmulatorAtomicUnlock(originaladdressrs1);
+#endif
 }
 
 #endif
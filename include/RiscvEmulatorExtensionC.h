@@ -15,7 +15,11 @@
 #include <stdint.h>
 
 #include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorEvent.h"
+#include "RiscvEmulatorHistogram.h"
 #include "RiscvEmulatorHook.h"
+#include "RiscvEmulatorPredictor.h"
+#include "RiscvEmulatorProfile.h"
 #include "RiscvEmulatorType.h"
 
 /**
@@ -28,17 +32,22 @@ static inline void RiscvEmulatorC_ADDI4SPN(
     void *sp,
     const uint16_t nzuimm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_ADDI4SPN);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.addi4spn";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = nzuimm;
-    hc.immlength = sizeof(nzuimm);
-    hc.immname = "nzuimm";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_ADDI4SPN;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = nzuimm;
+        hc.immlength = sizeof(nzuimm);
+        hc.immname = HOOK_IMMEDIATE_NZUIMM;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -48,8 +57,10 @@ static inline void RiscvEmulatorC_ADDI4SPN(
     *(int32_t *)rd = *(int32_t *)sp + nzuimm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -68,21 +79,26 @@ static inline void RiscvEmulatorC_LW(
 
     uint32_t memorylocation = *(int32_t *)rs1 + offset;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_LW);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.lw";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = offset;
-    hc.immlength = sizeof(offset);
-    hc.immname = "offset";
-    hc.memorylocation = memorylocation;
-    hc.length = length;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_LW;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = offset;
+        hc.immlength = sizeof(offset);
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        hc.memorylocation = memorylocation;
+        hc.length = length;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
 #if (RVE_E_ZICSR == 1)
@@ -91,11 +107,20 @@ static inline void RiscvEmulatorC_LW(
     }
 #endif
 
-    RiscvEmulatorLoad(memorylocation, rd, length);
+    RiscvEmulatorOpsLoad(state, memorylocation, rd, length);
+
+#if (RVE_E_ASYNC == 1)
+    // The load is executed again when resumed.
+    if (state->pending.kind == PENDING_LOAD) {
+        return;
+    }
+#endif
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -114,21 +139,26 @@ static inline void RiscvEmulatorC_SW(
 
     uint32_t memorylocation = *(int32_t *)rs1 + offset;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_SW);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.sw";
-    hc.hook = HOOK_BEGIN;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    hc.imm = offset;
-    hc.immlength = sizeof(offset);
-    hc.immname = "offset";
-    hc.memorylocation = memorylocation;
-    hc.length = length;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_SW;
+        hc.hook = HOOK_BEGIN;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        hc.imm = offset;
+        hc.immlength = sizeof(offset);
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        hc.memorylocation = memorylocation;
+        hc.length = length;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
 #if (RVE_E_ZICSR == 1)
@@ -137,11 +167,13 @@ static inline void RiscvEmulatorC_SW(
     }
 #endif
 
-    RiscvEmulatorStore(memorylocation, rs2, length);
+    RiscvEmulatorOpsStore(state, memorylocation, rs2, length);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -154,18 +186,23 @@ static inline void RiscvEmulatorC_ADDI(
     void *rd,
     const int8_t nzimm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_ADDI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.addi";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = nzimm;
-    hc.immlength = sizeof(nzimm);
-    hc.immissigned = 1;
-    hc.immname = "nzimm";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_ADDI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = nzimm;
+        hc.immlength = sizeof(nzimm);
+        hc.immissigned = 1;
+        hc.immname = HOOK_IMMEDIATE_NZIMM;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -175,8 +212,10 @@ static inline void RiscvEmulatorC_ADDI(
     *(int32_t *)rd = *(int32_t *)rd + nzimm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -188,24 +227,33 @@ static inline void RiscvEmulatorC_JAL(
     void *ra,
     const int16_t offset) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_JAL);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.jal";
-    hc.hook = HOOK_BEGIN;
-    hc.imm = offset;
-    hc.immlength = sizeof(offset);
-    hc.immissigned = 1;
-    hc.immname = "offset";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_JAL;
+        hc.hook = HOOK_BEGIN;
+        hc.imm = offset;
+        hc.immlength = sizeof(offset);
+        hc.immissigned = 1;
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     *(uint32_t *)ra = state->programcounter + 2;
     state->programcounternext = state->programcounter + offset;
+    RiscvEmulatorProfileJump(state, 1, 0, state->programcounternext);
+    RiscvEmulatorPredictorJump(state, 1, 0, state->programcounternext);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -218,24 +266,33 @@ static inline void RiscvEmulatorC_JALR(
     void *rs1,
     void *ra) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_JALR);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.instruction = "c.jalr";
-    hc.hook = HOOK_BEGIN;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.instruction = HOOK_INSTRUCTION_C_JALR;
+        hc.hook = HOOK_BEGIN;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     uint32_t originalvaluers1 = *(int32_t *)rs1;
 
     *(uint32_t *)ra = state->programcounter + 2;
     state->programcounternext = (originalvaluers1 & (UINT32_MAX - 1));
+    RiscvEmulatorProfileJump(state, 1, rs1num, state->programcounternext);
+    RiscvEmulatorPredictorJump(state, 1, rs1num, state->programcounternext);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -246,23 +303,31 @@ static inline void RiscvEmulatorC_J(
     RiscvEmulatorState_t *state __attribute__((unused)),
     const int16_t offset) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_J);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.j";
-    hc.hook = HOOK_BEGIN;
-    hc.imm = offset;
-    hc.immlength = sizeof(offset);
-    hc.immissigned = 1;
-    hc.immname = "offset";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_J;
+        hc.hook = HOOK_BEGIN;
+        hc.imm = offset;
+        hc.immlength = sizeof(offset);
+        hc.immissigned = 1;
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     state->programcounternext = state->programcounter + offset;
+    RiscvEmulatorPredictorJump(state, 0, 0, state->programcounternext);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -274,21 +339,30 @@ static inline void RiscvEmulatorC_JR(
     const uint8_t rs1num __attribute__((unused)),
     void *rs1) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_JR);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.jr";
-    hc.hook = HOOK_BEGIN;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_JR;
+        hc.hook = HOOK_BEGIN;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     state->programcounternext = *(int32_t *)rs1 & (UINT32_MAX - 1);
+    RiscvEmulatorProfileJump(state, 0, rs1num, state->programcounternext);
+    RiscvEmulatorPredictorJump(state, 0, rs1num, state->programcounternext);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -301,27 +375,37 @@ static inline void RiscvEmulatorC_BEQZ(
     void *rs1,
     const int16_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_BEQZ);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.beqz";
-    hc.hook = HOOK_BEGIN;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immlength = sizeof(imm);
-    hc.immissigned = 1;
-    hc.immname = "offset";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_BEQZ;
+        hc.hook = HOOK_BEGIN;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immlength = sizeof(imm);
+        hc.immissigned = 1;
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
+    RiscvEmulatorPredictorBranch(state, *(int32_t *)rs1 == 0, state->programcounter + imm);
+
     if (*(int32_t *)rs1 == 0) {
+        RiscvEmulatorEvent(state, EVENT_BRANCH_TAKEN);
         state->programcounternext = state->programcounter + imm;
     };
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -334,27 +418,37 @@ static inline void RiscvEmulatorC_BNEZ(
     void *rs1,
     const int16_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_BNEZ);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.bnez";
-    hc.hook = HOOK_BEGIN;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immlength = sizeof(imm);
-    hc.immissigned = 1;
-    hc.immname = "offset";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_BNEZ;
+        hc.hook = HOOK_BEGIN;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immlength = sizeof(imm);
+        hc.immissigned = 1;
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
+    RiscvEmulatorPredictorBranch(state, *(int32_t *)rs1 != 0, state->programcounter + imm);
+
     if (*(int32_t *)rs1 != 0) {
+        RiscvEmulatorEvent(state, EVENT_BRANCH_TAKEN);
         state->programcounternext = state->programcounter + imm;
     };
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -367,17 +461,22 @@ static inline void RiscvEmulatorC_SLLI(
     void *rd,
     const uint8_t shamt) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_SLLI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.slli";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = shamt;
-    hc.immlength = sizeof(shamt);
-    hc.immname = "shamt";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_SLLI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = shamt;
+        hc.immlength = sizeof(shamt);
+        hc.immname = HOOK_IMMEDIATE_SHAMT;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -387,8 +486,10 @@ static inline void RiscvEmulatorC_SLLI(
     *(uint32_t *)rd = *(uint32_t *)rd << shamt;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -401,17 +502,22 @@ static inline void RiscvEmulatorC_LI(
     void *rd,
     const int8_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_LI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.li";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = imm;
-    hc.immlength = sizeof(imm);
-    hc.immissigned = 1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_LI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = imm;
+        hc.immlength = sizeof(imm);
+        hc.immissigned = 1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -421,8 +527,10 @@ static inline void RiscvEmulatorC_LI(
     *(int32_t *)rd = imm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -443,18 +551,23 @@ static inline void RiscvEmulatorC_ADDI16SP(
 
     int16_t nzimm = immdecoder.imm;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_ADDI16SP);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.addi16sp";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = nzimm;
-    hc.immissigned = 1;
-    hc.immlength = sizeof(nzimm);
-    hc.immname = "nzimm";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_ADDI16SP;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = nzimm;
+        hc.immissigned = 1;
+        hc.immlength = sizeof(nzimm);
+        hc.immname = HOOK_IMMEDIATE_NZIMM;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (nzimm == 0) {
@@ -464,8 +577,10 @@ static inline void RiscvEmulatorC_ADDI16SP(
     *(int32_t *)rd += nzimm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -482,17 +597,22 @@ static inline void RiscvEmulatorC_LUI(
     immdecoder.bit.imm17 = state->instruction.cilui.imm17;
     int32_t nzimm = immdecoder.imm;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_LUI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.lui";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = nzimm;
-    hc.immissigned = 1;
-    hc.immname = "nzimm";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_LUI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = nzimm;
+        hc.immissigned = 1;
+        hc.immname = HOOK_IMMEDIATE_NZIMM;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -502,8 +622,10 @@ static inline void RiscvEmulatorC_LUI(
     *(int32_t *)rd = nzimm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -516,17 +638,22 @@ static inline void RiscvEmulatorC_SRLI(
     void *rd,
     uint8_t shamt) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_SRLI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.srli";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = shamt;
-    hc.immlength = sizeof(shamt);
-    hc.immname = "shamt";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_SRLI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = shamt;
+        hc.immlength = sizeof(shamt);
+        hc.immname = HOOK_IMMEDIATE_SHAMT;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -536,8 +663,10 @@ static inline void RiscvEmulatorC_SRLI(
     *(uint32_t *)rd = *(uint32_t *)rd >> shamt;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -550,17 +679,22 @@ static inline void RiscvEmulatorC_SRAI(
     void *rd,
     uint8_t shamt) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_SRAI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.srai";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = shamt;
-    hc.immlength = sizeof(shamt);
-    hc.immname = "shamt";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_SRAI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = shamt;
+        hc.immlength = sizeof(shamt);
+        hc.immname = HOOK_IMMEDIATE_SHAMT;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -570,8 +704,10 @@ static inline void RiscvEmulatorC_SRAI(
     *(int32_t *)rd = *(int32_t *)rd >> shamt;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -584,17 +720,22 @@ static inline void RiscvEmulatorC_ANDI(
     void *rd,
     int8_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_ANDI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.andi";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = imm;
-    hc.immlength = sizeof(imm);
-    hc.immissigned = 1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_ANDI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = imm;
+        hc.immlength = sizeof(imm);
+        hc.immissigned = 1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -604,8 +745,10 @@ static inline void RiscvEmulatorC_ANDI(
     *(int32_t *)rd = *(int32_t *)rd & imm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -619,16 +762,21 @@ static inline void RiscvEmulatorC_SUB(
     const uint8_t rs2num __attribute__((unused)),
     void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_SUB);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.sub";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_SUB;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -638,8 +786,10 @@ static inline void RiscvEmulatorC_SUB(
     *(int32_t *)rd = *(int32_t *)rd - *(int32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -653,16 +803,21 @@ static inline void RiscvEmulatorC_XOR(
     const uint8_t rs2num __attribute__((unused)),
     void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_XOR);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.xor";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_XOR;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -672,8 +827,10 @@ static inline void RiscvEmulatorC_XOR(
     *(uint32_t *)rd = *(uint32_t *)rd ^ *(uint32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -687,16 +844,21 @@ static inline void RiscvEmulatorC_OR(
     const uint8_t rs2num __attribute__((unused)),
     void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_OR);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.or";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_OR;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -706,8 +868,10 @@ static inline void RiscvEmulatorC_OR(
     *(uint32_t *)rd = *(uint32_t *)rd | *(uint32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -721,16 +885,21 @@ static inline void RiscvEmulatorC_AND(
     const uint8_t rs2num __attribute__((unused)),
     void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_AND);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.or";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_AND;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -740,8 +909,10 @@ static inline void RiscvEmulatorC_AND(
     *(uint32_t *)rd = *(uint32_t *)rd & *(uint32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -757,29 +928,43 @@ static inline void RiscvEmulatorC_LWSP(
 
     uint32_t memorylocation = *(int32_t *)sp + offset;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_LWSP);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.lwsp";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = offset;
-    hc.immlength = sizeof(offset);
-    hc.immname = "offset";
-    hc.memorylocation = memorylocation;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_LWSP;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = offset;
+        hc.immlength = sizeof(offset);
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        hc.memorylocation = memorylocation;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
         return;
     }
 
-    RiscvEmulatorLoad(memorylocation, rd, sizeof(uint32_t));
+    RiscvEmulatorOpsLoad(state, memorylocation, rd, sizeof(uint32_t));
+
+#if (RVE_E_ASYNC == 1)
+    // The load is executed again when resumed.
+    if (state->pending.kind == PENDING_LOAD) {
+        return;
+    }
+#endif
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -793,16 +978,21 @@ static inline void RiscvEmulatorC_MV(
     const uint8_t rs2num __attribute__((unused)),
     void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_MV);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.mv";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_MV;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -812,8 +1002,10 @@ static inline void RiscvEmulatorC_MV(
     *(int32_t *)rd = *(int32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -822,12 +1014,16 @@ static inline void RiscvEmulatorC_MV(
  */
 static inline void RiscvEmulatorC_EBREAK(RiscvEmulatorState_t *state) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_EBREAK);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.ebreak";
-    hc.hook = HOOK_BEGIN;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        RiscvEmulatorHookContext_t hc = {0};
+        hc.instruction = HOOK_INSTRUCTION_C_EBREAK;
+        hc.hook = HOOK_BEGIN;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
 #if (RVE_E_ZICSR == 1)
@@ -835,7 +1031,7 @@ static inline void RiscvEmulatorC_EBREAK(RiscvEmulatorState_t *state) {
     state->csr.mtval = state->programcounter;
 #endif
 
-    RiscvEmulatorHandleEBREAK(state);
+    RiscvEmulatorOpsHandleEBREAK(state);
 }
 
 /**
@@ -848,16 +1044,21 @@ static inline void RiscvEmulatorC_ADD(
     const uint8_t rs2num __attribute__((unused)),
     void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_ADD);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.add";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_ADD;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -867,8 +1068,10 @@ static inline void RiscvEmulatorC_ADD(
     *(int32_t *)rd = *(int32_t *)rd + *(int32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -884,25 +1087,32 @@ static inline void RiscvEmulatorC_SWSP(
 
     uint32_t memorylocation = *(int32_t *)sp + offset;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_C_SWSP);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "c.swsp";
-    hc.hook = HOOK_BEGIN;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    hc.imm = offset;
-    hc.immlength = sizeof(offset);
-    hc.immname = "offset";
-    hc.memorylocation = memorylocation;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_C_SWSP;
+        hc.hook = HOOK_BEGIN;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        hc.imm = offset;
+        hc.immlength = sizeof(offset);
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        hc.memorylocation = memorylocation;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
-    RiscvEmulatorStore(memorylocation, rs2, sizeof(uint32_t));
+    RiscvEmulatorOpsStore(state, memorylocation, rs2, sizeof(uint32_t));
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
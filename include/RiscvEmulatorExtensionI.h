@@ -12,10 +12,15 @@
 
 #include "RiscvEmulatorConfig.h"
 
-#include <RiscvEmulatorImplementationSpecific.h>
+#include "RiscvEmulatorOps.h"
 
 #include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorEvent.h"
+#include "RiscvEmulatorHistogram.h"
 #include "RiscvEmulatorHook.h"
+#include "RiscvEmulatorInterrupt.h"
+#include "RiscvEmulatorPredictor.h"
+#include "RiscvEmulatorProfile.h"
 #include "RiscvEmulatorType.h"
 
 #include "RiscvEmulatorExtensionM.h"
@@ -38,19 +43,24 @@ static inline void RiscvEmulatorJALR(RiscvEmulatorState_t *state) {
 
     uint32_t jumptoprogramcounter = (*(uint32_t *)rs1 + imm) & (UINT32_MAX - 1);
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_JALR);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "jalr";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immissigned = 1;
-    hc.immname = "offset";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_JALR;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immissigned = 1;
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
 #if (RVE_E_ZICSR == 1) && (RVE_E_C != 1)
@@ -69,10 +79,14 @@ static inline void RiscvEmulatorJALR(RiscvEmulatorState_t *state) {
 
     // Execute jump.
     state->programcounternext = jumptoprogramcounter;
+    RiscvEmulatorProfileJump(state, rdnum, rs1num, jumptoprogramcounter);
+    RiscvEmulatorPredictorJump(state, rdnum, rs1num, jumptoprogramcounter);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -99,18 +113,23 @@ static inline void RiscvEmulatorADD(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ADD);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "add";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ADD;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -120,8 +139,10 @@ static inline void RiscvEmulatorADD(
     *(int32_t *)rd = *(int32_t *)rs1 + *(int32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -136,19 +157,24 @@ static inline void RiscvEmulatorADDI(
     const void *rs1,
     const int16_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ADDI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "addi";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immissigned = 1;
-    hc.immlength = sizeof(imm);
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ADDI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immissigned = 1;
+        hc.immlength = sizeof(imm);
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -158,8 +184,10 @@ static inline void RiscvEmulatorADDI(
     *(int32_t *)rd = *(int32_t *)rs1 + imm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -175,18 +203,23 @@ static inline void RiscvEmulatorSUB(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SUB);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "sub";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SUB;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -196,8 +229,10 @@ static inline void RiscvEmulatorSUB(
     *(int32_t *)rd = *(int32_t *)rs1 - *(int32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -213,18 +248,23 @@ static inline void RiscvEmulatorSLL(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SLL);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "sll";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SLL;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -234,8 +274,10 @@ static inline void RiscvEmulatorSLL(
     *(uint32_t *)rd = *(uint32_t *)rs1 << (*(uint32_t *)rs2 & 0b11111);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -250,19 +292,24 @@ static inline void RiscvEmulatorSLLI(
     const void *rs1,
     const uint8_t shamt) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SLLI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "slli";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = shamt;
-    hc.immlength = sizeof(shamt);
-    hc.immname = "shamt";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SLLI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = shamt;
+        hc.immlength = sizeof(shamt);
+        hc.immname = HOOK_IMMEDIATE_SHAMT;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -272,8 +319,10 @@ static inline void RiscvEmulatorSLLI(
     *(uint32_t *)rd = *(uint32_t *)rs1 << (shamt & 0b11111);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -289,18 +338,23 @@ static inline void RiscvEmulatorSLT(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SLT);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "slt";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SLT;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -310,8 +364,10 @@ static inline void RiscvEmulatorSLT(
     *(int32_t *)rd = (*(int32_t *)rs1 < *(int32_t *)rs2);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -326,18 +382,23 @@ static inline void RiscvEmulatorSLTI(
     const void *rs1,
     const int16_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SLTI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "slti";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immlength = (sizeof(imm));
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SLTI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immlength = (sizeof(imm));
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -347,8 +408,10 @@ static inline void RiscvEmulatorSLTI(
     *(int32_t *)rd = (*(int32_t *)rs1 < imm);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -364,18 +427,23 @@ static inline void RiscvEmulatorSLTU(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SLTU);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "sltu";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SLTU;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -385,8 +453,10 @@ static inline void RiscvEmulatorSLTU(
     *(uint32_t *)rd = (*(uint32_t *)rs1 < *(uint32_t *)rs2);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -401,18 +471,23 @@ static inline void RiscvEmulatorSLTIU(
     const void *rs1,
     const uint32_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SLTIU);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "sltiu";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immlength = (sizeof(imm));
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SLTIU;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immlength = (sizeof(imm));
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -422,8 +497,10 @@ static inline void RiscvEmulatorSLTIU(
     *(uint32_t *)rd = (*(uint32_t *)rs1 < imm);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -439,18 +516,23 @@ static inline void RiscvEmulatorXOR(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_XOR);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "xor";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_XOR;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -460,8 +542,10 @@ static inline void RiscvEmulatorXOR(
     *(uint32_t *)rd = *(uint32_t *)rs1 ^ *(uint32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -476,18 +560,23 @@ static inline void RiscvEmulatorXORI(
     const void *rs1,
     const uint32_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_XORI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "xori";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immlength = (sizeof(imm));
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_XORI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immlength = (sizeof(imm));
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -497,8 +586,10 @@ static inline void RiscvEmulatorXORI(
     *(uint32_t *)rd = *(uint32_t *)rs1 ^ imm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -514,18 +605,23 @@ static inline void RiscvEmulatorSRL(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SRL);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "srl";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SRL;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -535,8 +631,10 @@ static inline void RiscvEmulatorSRL(
     *(uint32_t *)rd = *(uint32_t *)rs1 >> (*(uint32_t *)rs2 & 0b11111);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -551,19 +649,24 @@ static inline void RiscvEmulatorSRLI(
     const void *rs1,
     const uint8_t shamt) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SRLI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "srli";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = shamt;
-    hc.immlength = sizeof(shamt);
-    hc.immname = "shamt";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SRLI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = shamt;
+        hc.immlength = sizeof(shamt);
+        hc.immname = HOOK_IMMEDIATE_SHAMT;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -573,8 +676,10 @@ static inline void RiscvEmulatorSRLI(
     *(uint32_t *)rd = *(uint32_t *)rs1 >> (shamt & 0b11111);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -590,18 +695,23 @@ static inline void RiscvEmulatorSRA(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SRA);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "sra";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SRA;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -611,8 +721,10 @@ static inline void RiscvEmulatorSRA(
     *(int32_t *)rd = *(int32_t *)rs1 >> (*(uint32_t *)rs2 & 0b11111);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -627,19 +739,24 @@ static inline void RiscvEmulatorSRAI(
     const void *rs1,
     const uint8_t shamt) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SRAI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "srai";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = shamt;
-    hc.immlength = sizeof(shamt);
-    hc.immname = "shamt";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SRAI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = shamt;
+        hc.immlength = sizeof(shamt);
+        hc.immname = HOOK_IMMEDIATE_SHAMT;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -649,8 +766,10 @@ static inline void RiscvEmulatorSRAI(
     *(int32_t *)rd = *(int32_t *)rs1 >> (shamt & 0b11111);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -666,18 +785,23 @@ static inline void RiscvEmulatorOR(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_OR);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "or";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_OR;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -687,8 +811,10 @@ static inline void RiscvEmulatorOR(
     *(int32_t *)rd = *(int32_t *)rs1 | *(int32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -703,18 +829,23 @@ static inline void RiscvEmulatorORI(
     const void *rs1,
     const int16_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ORI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "ori";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immlength = (sizeof(imm));
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ORI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immlength = (sizeof(imm));
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -724,8 +855,10 @@ static inline void RiscvEmulatorORI(
     *(int32_t *)rd = *(int32_t *)rs1 | imm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -741,18 +874,23 @@ static inline void RiscvEmulatorAND(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_AND);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "and";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_AND;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -762,8 +900,10 @@ static inline void RiscvEmulatorAND(
     *(int32_t *)rd = *(int32_t *)rs1 & *(int32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -778,18 +918,23 @@ static inline void RiscvEmulatorANDI(
     const void *rs1,
     const int16_t imm) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ANDI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "andi";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immlength = (sizeof(imm));
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ANDI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immlength = (sizeof(imm));
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -799,8 +944,10 @@ static inline void RiscvEmulatorANDI(
     *(int32_t *)rd = *(int32_t *)rs1 & imm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -1118,39 +1265,44 @@ static inline void RiscvEmulatorOpcodeLoad(RiscvEmulatorState_t *state) {
     uint32_t memorylocation = imm + *(uint32_t *)rs1;
 
 #if (RVE_E_HOOK == 1)
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "unknown";
+    RiscvEmulatorHookContext_t hc;
+    uint8_t hookinstruction = HOOK_INSTRUCTION_UNKNOWN;
 #endif
 
     uint8_t length = 0;
     switch (state->instruction.itype.funct3) {
         case FUNCT3_LOAD_LB:
+            RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_LB);
 #if (RVE_E_HOOK == 1)
-            hc.instruction = "lb";
+            hookinstruction = HOOK_INSTRUCTION_LB;
 #endif
             length = sizeof(uint8_t);
             break;
         case FUNCT3_LOAD_LBU:
+            RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_LBU);
 #if (RVE_E_HOOK == 1)
-            hc.instruction = "lbu";
+            hookinstruction = HOOK_INSTRUCTION_LBU;
 #endif
             length = sizeof(uint8_t);
             break;
         case FUNCT3_LOAD_LH:
+            RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_LH);
 #if (RVE_E_HOOK == 1)
-            hc.instruction = "lh";
+            hookinstruction = HOOK_INSTRUCTION_LH;
 #endif
             length = sizeof(uint16_t);
             break;
         case FUNCT3_LOAD_LHU:
+            RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_LHU);
 #if (RVE_E_HOOK == 1)
-            hc.instruction = "lhu";
+            hookinstruction = HOOK_INSTRUCTION_LHU;
 #endif
             length = sizeof(uint16_t);
             break;
         case FUNCT3_LOAD_LW:
+            RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_LW);
 #if (RVE_E_HOOK == 1)
-            hc.instruction = "lw";
+            hookinstruction = HOOK_INSTRUCTION_LW;
 #endif
             length = sizeof(uint32_t);
             break;
@@ -1172,18 +1324,22 @@ static inline void RiscvEmulatorOpcodeLoad(RiscvEmulatorState_t *state) {
 #endif
 
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = imm;
-    hc.immlength = (sizeof(imm));
-    hc.immname = "offset";
-    hc.memorylocation = memorylocation;
-    hc.length = length;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = hookinstruction;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = imm;
+        hc.immlength = (sizeof(imm));
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        hc.memorylocation = memorylocation;
+        hc.length = length;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -1197,7 +1353,14 @@ static inline void RiscvEmulatorOpcodeLoad(RiscvEmulatorState_t *state) {
 #endif
 
     uint32_t value = 0;
-    RiscvEmulatorLoad(memorylocation, &value, length);
+    RiscvEmulatorOpsLoad(state, memorylocation, &value, length);
+
+#if (RVE_E_ASYNC == 1)
+    // The load is executed again when resumed, leave rd alone.
+    if (state->pending.kind == PENDING_LOAD) {
+        return;
+    }
+#endif
 
     switch (state->instruction.itype.funct3) {
         case FUNCT3_LOAD_LB:
@@ -1218,8 +1381,10 @@ static inline void RiscvEmulatorOpcodeLoad(RiscvEmulatorState_t *state) {
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -1241,27 +1406,30 @@ static inline void RiscvEmulatorOpcodeStore(RiscvEmulatorState_t *state) {
     uint32_t memorylocation = offset + *(uint32_t *)rs1;
 
 #if (RVE_E_HOOK == 1)
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "unkown";
+    RiscvEmulatorHookContext_t hc;
+    uint8_t hookinstruction = HOOK_INSTRUCTION_UNKNOWN;
 #endif
 
     uint8_t length = 0;
     switch (state->instruction.stype.funct3) {
         case FUNCT3_STORE_SW:
+            RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SW);
 #if (RVE_E_HOOK == 1)
-            hc.instruction = "sw";
+            hookinstruction = HOOK_INSTRUCTION_SW;
 #endif
             length = sizeof(uint32_t);
             break;
         case FUNCT3_STORE_SH:
+            RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SH);
 #if (RVE_E_HOOK == 1)
-            hc.instruction = "sh";
+            hookinstruction = HOOK_INSTRUCTION_SH;
 #endif
             length = sizeof(uint16_t);
             break;
         case FUNCT3_STORE_SB:
+            RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SB);
 #if (RVE_E_HOOK == 1)
-            hc.instruction = "sb";
+            hookinstruction = HOOK_INSTRUCTION_SB;
 #endif
             length = sizeof(uint8_t);
             break;
@@ -1283,19 +1451,23 @@ static inline void RiscvEmulatorOpcodeStore(RiscvEmulatorState_t *state) {
 #endif
 
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    hc.hook = HOOK_BEGIN;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    hc.imm = offset;
-    hc.immname = "offset";
-    hc.immlength = sizeof(offset);
-    hc.immissigned = 1;
-    hc.memorylocation = memorylocation;
-    hc.length = length;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = hookinstruction;
+        hc.hook = HOOK_BEGIN;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        hc.imm = offset;
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        hc.immlength = sizeof(offset);
+        hc.immissigned = 1;
+        hc.memorylocation = memorylocation;
+        hc.length = length;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
 #if (RVE_E_ZICSR == 1)
@@ -1304,11 +1476,13 @@ static inline void RiscvEmulatorOpcodeStore(RiscvEmulatorState_t *state) {
     }
 #endif
 
-    RiscvEmulatorStore(memorylocation, rs2, length);
+    RiscvEmulatorOpsStore(state, memorylocation, rs2, length);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -1325,19 +1499,24 @@ static inline void RiscvEmulatorBEQ(
     uint8_t *executebranch,
     RiscvEmulatorHookContext_t *hc) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    hc->instruction = "beq";
-    hc->hook = HOOK_BEGIN;
-    hc->rs1num = rs1num;
-    hc->rs1 = rs1;
-    hc->rs2num = rs2num;
-    hc->rs2 = rs2;
-    hc->imm = imm;
-    hc->immissigned = 1;
-    hc->immlength = sizeof(imm);
-    hc->immname = "offset";
-    RiscvEmulatorHook(state, hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_BEQ);
+
+#if (RVE_E_HOOK == 1)
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(hc, 0, sizeof(*hc));
+        hc->instruction = HOOK_INSTRUCTION_BEQ;
+        hc->hook = HOOK_BEGIN;
+        hc->rs1num = rs1num;
+        hc->rs1 = rs1;
+        hc->rs2num = rs2num;
+        hc->rs2 = rs2;
+        hc->imm = imm;
+        hc->immissigned = 1;
+        hc->immlength = sizeof(imm);
+        hc->immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, hc);
+    }
 #endif
 
     if (*(int32_t *)rs1 == *(int32_t *)rs2) {
@@ -1358,19 +1537,24 @@ static inline void RiscvEmulatorBNE(
     uint8_t *executebranch,
     RiscvEmulatorHookContext_t *hc) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    hc->instruction = "bne";
-    hc->hook = HOOK_BEGIN;
-    hc->rs1num = rs1num;
-    hc->rs1 = rs1;
-    hc->rs2num = rs2num;
-    hc->rs2 = rs2;
-    hc->imm = imm;
-    hc->immissigned = 1;
-    hc->immlength = sizeof(imm);
-    hc->immname = "offset";
-    RiscvEmulatorHook(state, hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_BNE);
+
+#if (RVE_E_HOOK == 1)
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(hc, 0, sizeof(*hc));
+        hc->instruction = HOOK_INSTRUCTION_BNE;
+        hc->hook = HOOK_BEGIN;
+        hc->rs1num = rs1num;
+        hc->rs1 = rs1;
+        hc->rs2num = rs2num;
+        hc->rs2 = rs2;
+        hc->imm = imm;
+        hc->immissigned = 1;
+        hc->immlength = sizeof(imm);
+        hc->immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, hc);
+    }
 #endif
 
     if (*(int32_t *)rs1 != *(int32_t *)rs2) {
@@ -1391,19 +1575,24 @@ static inline void RiscvEmulatorBGE(
     uint8_t *executebranch,
     RiscvEmulatorHookContext_t *hc) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    hc->instruction = "bge";
-    hc->hook = HOOK_BEGIN;
-    hc->rs1num = rs1num;
-    hc->rs1 = rs1;
-    hc->rs2num = rs2num;
-    hc->rs2 = rs2;
-    hc->imm = imm;
-    hc->immissigned = 1;
-    hc->immlength = sizeof(imm);
-    hc->immname = "offset";
-    RiscvEmulatorHook(state, hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_BGE);
+
+#if (RVE_E_HOOK == 1)
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(hc, 0, sizeof(*hc));
+        hc->instruction = HOOK_INSTRUCTION_BGE;
+        hc->hook = HOOK_BEGIN;
+        hc->rs1num = rs1num;
+        hc->rs1 = rs1;
+        hc->rs2num = rs2num;
+        hc->rs2 = rs2;
+        hc->imm = imm;
+        hc->immissigned = 1;
+        hc->immlength = sizeof(imm);
+        hc->immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, hc);
+    }
 #endif
 
     if (*(int32_t *)rs1 >= *(int32_t *)rs2) {
@@ -1424,19 +1613,24 @@ static inline void RiscvEmulatorBGEU(
     uint8_t *executebranch,
     RiscvEmulatorHookContext_t *hc) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    hc->instruction = "bgeu";
-    hc->hook = HOOK_BEGIN;
-    hc->rs1num = rs1num;
-    hc->rs1 = rs1;
-    hc->rs2num = rs2num;
-    hc->rs2 = rs2;
-    hc->imm = imm;
-    hc->immissigned = 1;
-    hc->immlength = sizeof(imm);
-    hc->immname = "offset";
-    RiscvEmulatorHook(state, hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_BGEU);
+
+#if (RVE_E_HOOK == 1)
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(hc, 0, sizeof(*hc));
+        hc->instruction = HOOK_INSTRUCTION_BGEU;
+        hc->hook = HOOK_BEGIN;
+        hc->rs1num = rs1num;
+        hc->rs1 = rs1;
+        hc->rs2num = rs2num;
+        hc->rs2 = rs2;
+        hc->imm = imm;
+        hc->immissigned = 1;
+        hc->immlength = sizeof(imm);
+        hc->immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, hc);
+    }
 #endif
 
     if (*(uint32_t *)rs1 >= *(uint32_t *)rs2) {
@@ -1457,19 +1651,24 @@ static inline void RiscvEmulatorBLT(
     uint8_t *executebranch,
     RiscvEmulatorHookContext_t *hc) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    hc->instruction = "blt";
-    hc->hook = HOOK_BEGIN;
-    hc->rs1num = rs1num;
-    hc->rs1 = rs1;
-    hc->rs2num = rs2num;
-    hc->rs2 = rs2;
-    hc->imm = imm;
-    hc->immissigned = 1;
-    hc->immlength = sizeof(imm);
-    hc->immname = "offset";
-    RiscvEmulatorHook(state, hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_BLT);
+
+#if (RVE_E_HOOK == 1)
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(hc, 0, sizeof(*hc));
+        hc->instruction = HOOK_INSTRUCTION_BLT;
+        hc->hook = HOOK_BEGIN;
+        hc->rs1num = rs1num;
+        hc->rs1 = rs1;
+        hc->rs2num = rs2num;
+        hc->rs2 = rs2;
+        hc->imm = imm;
+        hc->immissigned = 1;
+        hc->immlength = sizeof(imm);
+        hc->immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, hc);
+    }
 #endif
 
     if (*(int32_t *)rs1 < *(int32_t *)rs2) {
@@ -1490,19 +1689,24 @@ static inline void RiscvEmulatorBLTU(
     uint8_t *executebranch,
     RiscvEmulatorHookContext_t *hc) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    hc->instruction = "bltu";
-    hc->hook = HOOK_BEGIN;
-    hc->rs1num = rs1num;
-    hc->rs1 = rs1;
-    hc->rs2num = rs2num;
-    hc->rs2 = rs2;
-    hc->imm = imm;
-    hc->immissigned = 1;
-    hc->immlength = sizeof(imm);
-    hc->immname = "offset";
-    RiscvEmulatorHook(state, hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_BLTU);
+
+#if (RVE_E_HOOK == 1)
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(hc, 0, sizeof(*hc));
+        hc->instruction = HOOK_INSTRUCTION_BLTU;
+        hc->hook = HOOK_BEGIN;
+        hc->rs1num = rs1num;
+        hc->rs1 = rs1;
+        hc->rs2num = rs2num;
+        hc->rs2 = rs2;
+        hc->imm = imm;
+        hc->immissigned = 1;
+        hc->immlength = sizeof(imm);
+        hc->immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, hc);
+    }
 #endif
 
     if (*(uint32_t *)rs1 < *(uint32_t *)rs2) {
@@ -1528,11 +1732,7 @@ static inline void RiscvEmulatorOpcodeBranch(RiscvEmulatorState_t *state) {
     immdecoder.bit.imm12 = state->instruction.btype.imm12;
     int16_t imm = immdecoder.imm;
 
-#if (RVE_E_HOOK == 1)
-    RiscvEmulatorHookContext_t hc = {0};
-#else
     RiscvEmulatorHookContext_t hc;
-#endif
 
     switch (state->instruction.btype.funct3) {
         case FUNCT3_BRANCH_BEQ:
@@ -1558,7 +1758,10 @@ static inline void RiscvEmulatorOpcodeBranch(RiscvEmulatorState_t *state) {
             return;
     }
 
+    RiscvEmulatorPredictorBranch(state, executebranch == BRANCH_YES, state->programcounter + imm);
+
     if (executebranch == BRANCH_YES) {
+        RiscvEmulatorEvent(state, EVENT_BRANCH_TAKEN);
         state->programcounternext = state->programcounter + imm;
 
 #if (RVE_E_ZICSR == 1) && (RVE_E_C != 1)
@@ -1570,8 +1773,10 @@ static inline void RiscvEmulatorOpcodeBranch(RiscvEmulatorState_t *state) {
 #endif
 
 #if (RVE_E_HOOK == 1)
-        hc.hook = HOOK_END;
-        RiscvEmulatorHook(state, &hc);
+        if (state->hookexists) {
+            hc.hook = HOOK_END;
+            RiscvEmulatorCallHook(state, &hc);
+        }
 #endif
     }
 }
@@ -1588,17 +1793,22 @@ static inline void RiscvEmulatorAUIPC(RiscvEmulatorState_t *state) {
 
     uint8_t rdnum = state->instruction.utype.rd;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_AUIPC);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    void *rd = &state->reg.x[rdnum];
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "auipc";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.upperimmediate = upperimmediate;
-    hc.imm = imm;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        void *rd = &state->reg.x[rdnum];
+        hc.instruction = HOOK_INSTRUCTION_AUIPC;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.upperimmediate = upperimmediate;
+        hc.imm = imm;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum != 0) {
@@ -1606,8 +1816,10 @@ static inline void RiscvEmulatorAUIPC(RiscvEmulatorState_t *state) {
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -1624,15 +1836,20 @@ static inline void RiscvEmulatorLUI(RiscvEmulatorState_t *state) {
 
     uint32_t imm = immdecoder.imm;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_LUI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "lui";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = imm;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_LUI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = imm;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum != 0) {
@@ -1640,8 +1857,10 @@ static inline void RiscvEmulatorLUI(RiscvEmulatorState_t *state) {
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -1661,17 +1880,22 @@ static inline void RiscvEmulatorJAL(RiscvEmulatorState_t *state) {
 
     uint32_t jumptoprogramcounter = state->programcounter + immdecoder.imm;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_JAL);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "jal";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = immdecoder.imm;
-    hc.immissigned = 1;
-    hc.immname = "offset";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_JAL;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = immdecoder.imm;
+        hc.immissigned = 1;
+        hc.immname = HOOK_IMMEDIATE_OFFSET;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 #if (RVE_E_ZICSR == 1) && (RVE_E_C != 1)
     // Check if jumptoprogramcounter is aligned.
@@ -1689,10 +1913,14 @@ static inline void RiscvEmulatorJAL(RiscvEmulatorState_t *state) {
 
     // Execute jump.
     state->programcounternext = jumptoprogramcounter;
+    RiscvEmulatorProfileJump(state, rdnum, 0, jumptoprogramcounter);
+    RiscvEmulatorPredictorJump(state, rdnum, 0, jumptoprogramcounter);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -1701,19 +1929,23 @@ static inline void RiscvEmulatorJAL(RiscvEmulatorState_t *state) {
  */
 static inline void RiscvEmulatorECALL(RiscvEmulatorState_t *state) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ECALL);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "ecall";
-    hc.hook = HOOK_BEGIN;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        RiscvEmulatorHookContext_t hc = {0};
+        hc.instruction = HOOK_INSTRUCTION_ECALL;
+        hc.hook = HOOK_BEGIN;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
 #if (RVE_E_ZICSR == 1)
     state->trapflag.environmentcallfrommmode = 1;
 #endif
 
-    RiscvEmulatorHandleECALL(state);
+    RiscvEmulatorOpsHandleECALL(state);
 }
 
 /**
@@ -1721,12 +1953,16 @@ static inline void RiscvEmulatorECALL(RiscvEmulatorState_t *state) {
  */
 static inline void RiscvEmulatorEBREAK(RiscvEmulatorState_t *state) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_EBREAK);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "ebreak";
-    hc.hook = HOOK_BEGIN;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        RiscvEmulatorHookContext_t hc = {0};
+        hc.instruction = HOOK_INSTRUCTION_EBREAK;
+        hc.hook = HOOK_BEGIN;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
 #if (RVE_E_ZICSR == 1)
@@ -1734,7 +1970,43 @@ static inline void RiscvEmulatorEBREAK(RiscvEmulatorState_t *state) {
     state->csr.mtval = state->programcounter;
 #endif
 
-    RiscvEmulatorHandleEBREAK(state);
+    RiscvEmulatorOpsHandleEBREAK(state);
+}
+
+/**
+ * Wait for an interrupt.
+ *
+ * Without interrupts this is a no-op. Otherwise the hart stops executing instructions until an interrupt is pending
+ * and enabled in mie, see RiscvEmulatorRun().
+ */
+static inline void RiscvEmulatorWFI(RiscvEmulatorState_t *state) {
+
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_WFI);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_WFI;
+        hc.hook = HOOK_BEGIN;
+        RiscvEmulatorCallHook(state, &hc);
+    }
+#endif
+
+#if (RVE_E_INTERRUPT == 1)
+    if ((state->csr.mip.mip & state->csr.mie.mie) == 0) {
+        state->waiting = 1;
+        RiscvEmulatorEndChunk(state);
+    }
+#endif
+
+#if (RVE_E_HOOK == 1)
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
+#endif
 }
 
 /**
@@ -1760,6 +2032,9 @@ static inline void RiscvEmulatorOpcodeSystem(RiscvEmulatorState_t *state) {
                 case FUNCT12_EBREAK:
                     RiscvEmulatorEBREAK(state);
                     break;
+                case FUNCT12_WFI:
+                    RiscvEmulatorWFI(state);
+                    break;
                 default:
                     detectedUnknownInstruction = 1;
                     break;
@@ -1786,6 +2061,12 @@ static inline void RiscvEmulatorOpcodeSystem(RiscvEmulatorState_t *state) {
             return;
         }
 
+        // CSR numbers starting with 0b11 are read-only.
+        if ((csrnum >> 10) == 0b11 && RiscvEmulatorCSRWrites(state)) {
+            state->trapflag.illegalinstruction = 1;
+            return;
+        }
+
         switch (state->instruction.itypecsr.funct3) {
             case FUNCT3_CSR_CSRRW:
                 RiscvEmulatorCSRRW(state, rdnum, rd, rs1num, rs1, csrnum, csr);
@@ -1809,6 +2090,29 @@ static inline void RiscvEmulatorOpcodeSystem(RiscvEmulatorState_t *state) {
                 detectedUnknownInstruction = 1;
                 break;
         }
+
+#if (RVE_E_ZICNTR == 1)
+        if (csr == &state->counter && RiscvEmulatorCSRWrites(state)) {
+            RiscvEmulatorZicntrWrite(state, csrnum);
+        }
+#endif
+
+#if (RVE_E_IDLE == 1)
+        // Reading a CSR has no side effect.
+        if (RiscvEmulatorCSRWrites(state)) {
+            RiscvEmulatorIdleSideEffect(state);
+        }
+#endif
+
+#if (RVE_E_INTERRUPT == 1)
+        // An interrupt may have been enabled or raised, not by a read.
+        if ((csr == &state->csr.mstatus ||
+             csr == &state->csr.mie ||
+             csr == &state->csr.mip) &&
+            RiscvEmulatorCSRWrites(state)) {
+            RiscvEmulatorAttention(state);
+        }
+#endif
     }
 
 #endif
@@ -1822,15 +2126,24 @@ static inline void RiscvEmulatorOpcodeSystem(RiscvEmulatorState_t *state) {
  * Excutes the fence instuction.
  *
  * This does nothing in this emulator because all memory access is always completely processed.
+ * Except with multiple harts, where the host may reorder the memory accesses of a hart as seen by other harts.
  */
 static inline void RiscvEmulatorFence(
     RiscvEmulatorState_t *state __attribute__((unused))) {
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_FENCE);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "fence";
-    hc.hook = HOOK_BEGIN;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        RiscvEmulatorHookContext_t hc = {0};
+        hc.instruction = HOOK_INSTRUCTION_FENCE;
+        hc.hook = HOOK_BEGIN;
+        RiscvEmulatorCallHook(state, &hc);
+    }
+#endif
+
+#if (RVE_E_SMP == 1)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
 #endif
 }
 
@@ -1842,12 +2155,16 @@ static inline void RiscvEmulatorFence(
  */
 static inline void RiscvEmulatorFencei(
     RiscvEmulatorState_t *state __attribute__((unused))) {
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_FENCEI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "fencei";
-    hc.hook = HOOK_BEGIN;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        RiscvEmulatorHookContext_t hc = {0};
+        hc.instruction = HOOK_INSTRUCTION_FENCEI;
+        hc.hook = HOOK_BEGIN;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 #endif
@@ -14,6 +14,7 @@
 
 #include "RiscvEmulatorConfig.h"
 #include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorHistogram.h"
 #include "RiscvEmulatorType.h"
 
 /**
@@ -28,18 +29,23 @@ static inline void RiscvEmulatorMUL(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_MUL);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "mul";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_MUL;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -49,8 +55,10 @@ static inline void RiscvEmulatorMUL(
     *(uint32_t *)rd = (*(uint32_t *)rs1 * *(uint32_t *)rs2);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -66,18 +74,23 @@ static inline void RiscvEmulatorMULH(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_MULH);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "mulh";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_MULH;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -88,8 +101,10 @@ static inline void RiscvEmulatorMULH(
     *(int32_t *)rd = (result >> 32);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -105,18 +120,23 @@ static inline void RiscvEmulatorMULHSU(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_MULHSU);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "mulhsu";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_MULHSU;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -127,8 +147,10 @@ static inline void RiscvEmulatorMULHSU(
     *(int32_t *)rd = (result >> 32);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -144,18 +166,23 @@ static inline void RiscvEmulatorMULHU(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_MULHU);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "mulhu";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_MULHU;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -166,8 +193,10 @@ static inline void RiscvEmulatorMULHU(
     *(uint32_t *)rd = (result >> 32);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -183,18 +212,23 @@ static inline void RiscvEmulatorDIV(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_DIV);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "div";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_DIV;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -212,8 +246,10 @@ static inline void RiscvEmulatorDIV(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -229,18 +265,23 @@ static inline void RiscvEmulatorDIVU(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_DIVU);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "divu";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_DIVU;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -255,8 +296,10 @@ static inline void RiscvEmulatorDIVU(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -272,18 +315,23 @@ static inline void RiscvEmulatorREM(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_REM);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "rem";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_REM;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -301,8 +349,10 @@ static inline void RiscvEmulatorREM(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -318,18 +368,23 @@ static inline void RiscvEmulatorREMU(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_REMU);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "remu";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_REMU;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -344,8 +399,10 @@ static inline void RiscvEmulatorREMU(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -14,6 +14,7 @@
 
 #include "RiscvEmulatorConfig.h"
 #include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorHistogram.h"
 #include "RiscvEmulatorType.h"
 
 /**
@@ -28,18 +29,25 @@ static inline void RiscvEmulatorSHADD(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
+    // SH1ADD, SH2ADD and SH3ADD are numbered in order of their shift.
+    uint8_t hookinstruction = HOOK_INSTRUCTION_SH1ADD - 1 + state->instruction.rtypeshift.funct3_shifts;
+    RiscvEmulatorHistogram(state, hookinstruction);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "shadd";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = hookinstruction;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -49,8 +57,10 @@ static inline void RiscvEmulatorSHADD(
     *(uint32_t *)rd = *(uint32_t *)rs2 + (*(uint32_t *)rs1 << state->instruction.rtypeshift.funct3_shifts);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -15,6 +15,7 @@
 #include <stdint.h>
 
 #include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorHistogram.h"
 #include "RiscvEmulatorType.h"
 
 /**
@@ -29,18 +30,23 @@ static inline void RiscvEmulatorANDN(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "andn";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ANDN);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ANDN;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -50,8 +56,10 @@ static inline void RiscvEmulatorANDN(
     *(uint32_t *)rd = *(uint32_t *)rs1 & ~*(uint32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -67,18 +75,23 @@ static inline void RiscvEmulatorORN(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "orn";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ORN);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ORN;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -88,8 +101,10 @@ static inline void RiscvEmulatorORN(
     *(uint32_t *)rd = *(uint32_t *)rs1 | ~*(uint32_t *)rs2;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -105,18 +120,23 @@ static inline void RiscvEmulatorXNOR(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "xnor";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_XNOR);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_XNOR;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -126,8 +146,10 @@ static inline void RiscvEmulatorXNOR(
     *(uint32_t *)rd = ~(*(uint32_t *)rs1 ^ *(uint32_t *)rs2);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -141,16 +163,21 @@ static inline void RiscvEmulatorCLZ(
     const uint8_t rs1num __attribute__((unused)),
     const void *rs1) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_CLZ);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "clz";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_CLZ;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -169,8 +196,10 @@ static inline void RiscvEmulatorCLZ(
     *(uint32_t *)rd = leadingzeros;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -184,16 +213,21 @@ static inline void RiscvEmulatorCTZ(
     const uint8_t rs1num __attribute__((unused)),
     const void *rs1) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_CTZ);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "ctz";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_CTZ;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -212,8 +246,10 @@ static inline void RiscvEmulatorCTZ(
     *(uint32_t *)rd = trailingzeros;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -227,16 +263,21 @@ static inline void RiscvEmulatorCPOP(
     const uint8_t rs1num __attribute__((unused)),
     const void *rs1) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_CPOP);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "cpop";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_CPOP;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -254,8 +295,10 @@ static inline void RiscvEmulatorCPOP(
     *(uint32_t *)rd = setbits;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -271,18 +314,23 @@ static inline void RiscvEmulatorMAX(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "max";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_MAX);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_MAX;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -296,8 +344,10 @@ static inline void RiscvEmulatorMAX(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -313,18 +363,23 @@ static inline void RiscvEmulatorMAXU(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "maxu";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_MAXU);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_MAXU;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -338,8 +393,10 @@ static inline void RiscvEmulatorMAXU(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -355,18 +412,23 @@ static inline void RiscvEmulatorMIN(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "min";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_MIN);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_MIN;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -380,8 +442,10 @@ static inline void RiscvEmulatorMIN(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -397,18 +461,23 @@ static inline void RiscvEmulatorMINU(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "minu";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_MINU);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_MINU;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -422,8 +491,10 @@ static inline void RiscvEmulatorMINU(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -437,16 +508,21 @@ static inline void RiscvEmulatorSEXT_B(
     const uint8_t rs1num __attribute__((unused)),
     const void *rs1) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SEXT_B);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "sext.b";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SEXT_B;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -456,8 +532,10 @@ static inline void RiscvEmulatorSEXT_B(
     *(int32_t *)rd = *(int8_t *)rs1;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -471,16 +549,21 @@ static inline void RiscvEmulatorSEXT_H(
     const uint8_t rs1num __attribute__((unused)),
     const void *rs1) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_SEXT_H);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "sext.h";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_SEXT_H;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -490,8 +573,10 @@ static inline void RiscvEmulatorSEXT_H(
     *(int32_t *)rd = *(int16_t *)rs1;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -505,16 +590,21 @@ static inline void RiscvEmulatorZEXT_H(
     const uint8_t rs1num __attribute__((unused)),
     const void *rs1) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ZEXT_H);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "zext.h";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ZEXT_H;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -524,8 +614,10 @@ static inline void RiscvEmulatorZEXT_H(
     *(uint32_t *)rd = *(uint16_t *)rs1;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -541,18 +633,23 @@ static inline void RiscvEmulatorROL(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "rol";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ROL);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ROL;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -564,8 +661,10 @@ static inline void RiscvEmulatorROL(
         *(uint32_t *)rs1 >> (32 - *(uint32_t *)rs2);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -581,18 +680,23 @@ static inline void RiscvEmulatorROR(
     const uint8_t rs2num __attribute__((unused)),
     const void *rs2) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "ror";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.rs2num = rs2num;
-    hc.rs2 = rs2;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ROR);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ROR;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.rs2num = rs2num;
+        hc.rs2 = rs2;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -604,8 +708,10 @@ static inline void RiscvEmulatorROR(
         *(uint32_t *)rs1 << (32 - *(uint32_t *)rs2);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -620,19 +726,24 @@ static inline void RiscvEmulatorRORI(
     const void *rs1,
     const uint8_t shamt) {
 
-#if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "rori";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.imm = shamt;
-    hc.immlength = sizeof(shamt);
-    hc.immname = "shamt";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_RORI);
+
+#if (RVE_E_HOOK == 1)
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_RORI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.imm = shamt;
+        hc.immlength = sizeof(shamt);
+        hc.immname = HOOK_IMMEDIATE_SHAMT;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -644,8 +755,10 @@ static inline void RiscvEmulatorRORI(
         *(uint32_t *)rs1 << (32 - shamt);
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -659,16 +772,21 @@ static inline void RiscvEmulatorORC_B(
     const uint8_t rs1num __attribute__((unused)),
     const void *rs1) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_ORC_B);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "orc.b";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_ORC_B;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -684,8 +802,10 @@ static inline void RiscvEmulatorORC_B(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -699,16 +819,21 @@ static inline void RiscvEmulatorREV8(
     const uint8_t rs1num __attribute__((unused)),
     const void *rs1) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_REV8);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "rev8";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_REV8;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum == 0) {
@@ -724,8 +849,10 @@ static inline void RiscvEmulatorREV8(
     *(uint32_t *)rd = temp;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -0,0 +1,107 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorExtensionZicntr_H_
+#define RiscvEmulatorExtensionZicntr_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_ZICNTR == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulatorBudget.h"
+#include "RiscvEmulatorClint.h"
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+#include "RiscvEmulatorExtensionZihpm.h"
+
+/**
+ * Instructions retired before the instruction being executed.
+ *
+ * RiscvEmulatorRun() only counts whole chunks, the position in the current chunk gives the exact value.
+ */
+static inline uint64_t RiscvEmulatorZicntrRetired(const RiscvEmulatorState_t *state) {
+    uint64_t retired = RiscvEmulatorRetired(state);
+
+    // Inside a chunk the instruction being executed is already counted.
+    if (state->chunk != state->budget) {
+        retired--;
+    }
+
+    return retired;
+}
+
+/**
+ * Get the 64-bit value of a counter.
+ *
+ * @param counter The low 5 bits of the CSR number: 0 cycle, 1 time, 2 instret.
+ */
+static inline uint64_t RiscvEmulatorZicntrCounter(const RiscvEmulatorState_t *state, const uint8_t counter) {
+    switch (counter) {
+        case 0:
+            return RiscvEmulatorZicntrRetired(state) + state->mcycleoffset;
+        case 1:
+#if (RVE_E_CLINT == 1)
+            return RiscvEmulatorClintTime(state);
+#else
+            return RiscvEmulatorZicntrRetired(state) + state->mcycleoffset;
+#endif
+        default:
+            return RiscvEmulatorZicntrRetired(state) + state->minstretoffset;
+    }
+}
+
+/**
+ * Get a counter CSR into state->counter, where CSR instructions can access it.
+ */
+static inline void *RiscvEmulatorZicntrRead(RiscvEmulatorState_t *state, const uint16_t csr) {
+    uint64_t value = RiscvEmulatorZicntrCounter(state, csr & 0x1F);
+
+    // CSR numbers 0xC80 and up hold the high half.
+    state->counter = (csr & 0x80) ? (uint32_t)(value >> 32) : (uint32_t)value;
+
+    return &state->counter;
+}
+
+/**
+ * Write state->counter back to mcycle, minstret, their high halves or a performance monitoring CSR after a CSR
+ * instruction wrote it.
+ *
+ * The instruction writing the counter does not increment it.
+ */
+static inline void RiscvEmulatorZicntrWrite(RiscvEmulatorState_t *state, const uint16_t csr) {
+    uint8_t counter = csr & 0x1F;
+
+#if (RVE_E_ZIHPM == 1)
+    if (counter >= 3) {
+        RiscvEmulatorZihpmWrite(state, csr);
+        return;
+    }
+#endif
+    uint64_t value = RiscvEmulatorZicntrCounter(state, counter);
+
+    if (csr & 0x80) {
+        value = ((uint64_t)state->counter << 32) | (uint32_t)value;
+    } else {
+        value = (value & 0xFFFFFFFF00000000) | state->counter;
+    }
+
+    // Counted from the next instruction on.
+    uint64_t retired = RiscvEmulatorRetired(state);
+
+    if (counter == 0) {
+        state->mcycleoffset = value - retired;
+    } else {
+        state->minstretoffset = value - retired;
+    }
+}
+
+#endif
+
+#endif
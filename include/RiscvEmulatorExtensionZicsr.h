@@ -14,22 +14,31 @@
 
 #include <stdint.h>
 
-#include <RiscvEmulatorImplementationSpecific.h>
+#include "RiscvEmulatorOps.h"
 
 #include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorHistogram.h"
 #include "RiscvEmulatorHook.h"
+#include "RiscvEmulatorInterrupt.h"
 #include "RiscvEmulatorType.h"
 
+#include "RiscvEmulatorExtensionZicntr.h"
+
 /**
  * Return from machine mode.
  */
 static inline void RiscvEmulatorMRET(RiscvEmulatorState_t *state) {
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_MRET);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "mret";
-    hc.hook = HOOK_BEGIN;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_MRET;
+        hc.hook = HOOK_BEGIN;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     // TODO: Determine what the new privilege mode will be according to the values of MPP and MPV in mstatus.
@@ -44,9 +53,16 @@ static inline void RiscvEmulatorMRET(RiscvEmulatorState_t *state) {
 
     state->programcounternext = state->csr.mepc;
 
+#if (RVE_E_INTERRUPT == 1)
+    // Interrupts may be enabled again.
+    RiscvEmulatorAttention(state);
+#endif
+
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -121,14 +137,46 @@ static inline void *RiscvEmulatorGetCSRAddress(RiscvEmulatorState_t *state, cons
             address = &state->csr.satp;
             break;
 
+#if (RVE_E_ZICNTR == 1)
+        // Counters and timers, computed when accessed.
+        case 0xB00:
+        case 0xB02:
+        case 0xB80:
+        case 0xB82:
+        case 0xC00:
+        case 0xC01:
+        case 0xC02:
+        case 0xC80:
+        case 0xC81:
+        case 0xC82:
+            address = RiscvEmulatorZicntrRead(state, csr);
+            break;
+#endif
+
         default:
+#if (RVE_E_ZIHPM == 1)
+            address = RiscvEmulatorZihpmRead(state, csr);
+            if (address != 0) {
+                break;
+            }
+#endif
             state->trapflag.illegalinstruction = 1;
-            RiscvEmulatorUnknownCSR(state);
+            RiscvEmulatorOpsUnknownCSR(state);
     }
 
     return address;
 }
 
+/**
+ * Check if the CSR instruction being executed writes the CSR.
+ */
+static inline uint8_t RiscvEmulatorCSRWrites(const RiscvEmulatorState_t *state) {
+    // CSRRS and CSRRC with rs1 or uimm 0 only read.
+    return state->instruction.itypecsr.funct3 == FUNCT3_CSR_CSRRW ||
+           state->instruction.itypecsr.funct3 == FUNCT3_CSR_CSRRWI ||
+           state->instruction.itypecsr.rs1 != 0;
+}
+
 /**
  * Atomic read and write CSR.
  */
@@ -141,18 +189,23 @@ static inline void RiscvEmulatorCSRRW(
     const uint16_t csrnum __attribute__((unused)),
     const void *csr) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_CSRRW);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "csrrw";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.csrnum = csrnum;
-    hc.csr = csr;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_CSRRW;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.csrnum = csrnum;
+        hc.csr = csr;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     uint32_t originalvaluers1 = *(uint32_t *)rs1;
@@ -165,8 +218,10 @@ static inline void RiscvEmulatorCSRRW(
     *(uint32_t *)csr = originalvaluers1;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -181,19 +236,24 @@ static inline void RiscvEmulatorCSRRWI(
     const uint16_t csrnum __attribute__((unused)),
     const void *csr) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_CSRRWI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "csrrwi";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = uimm;
-    hc.csrnum = csrnum;
-    hc.csr = csr;
-    hc.immlength = sizeof(uimm);
-    hc.immname = "uimm";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_CSRRWI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = uimm;
+        hc.csrnum = csrnum;
+        hc.csr = csr;
+        hc.immlength = sizeof(uimm);
+        hc.immname = HOOK_IMMEDIATE_UIMM;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     // Read old value into destination register when requested.
@@ -204,8 +264,10 @@ static inline void RiscvEmulatorCSRRWI(
     *(uint32_t *)csr = uimm;
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -223,18 +285,23 @@ static inline void RiscvEmulatorCSRRS(
 
     int32_t initialrs1value = *(uint32_t *)rs1;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_CSRRS);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "csrrs";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.csrnum = csrnum;
-    hc.csr = csr;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_CSRRS;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.csrnum = csrnum;
+        hc.csr = csr;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum != 0) {
@@ -247,8 +314,10 @@ static inline void RiscvEmulatorCSRRS(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -263,19 +332,24 @@ static inline void RiscvEmulatorCSRRSI(
     const uint16_t csrnum __attribute__((unused)),
     const void *csr) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_CSRRSI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "csrrsi";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = uimm;
-    hc.csrnum = csrnum;
-    hc.csr = csr;
-    hc.immlength = sizeof(uimm);
-    hc.immname = "uimm";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_CSRRSI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = uimm;
+        hc.csrnum = csrnum;
+        hc.csr = csr;
+        hc.immlength = sizeof(uimm);
+        hc.immname = HOOK_IMMEDIATE_UIMM;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum != 0) {
@@ -288,8 +362,10 @@ static inline void RiscvEmulatorCSRRSI(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -307,18 +383,23 @@ static inline void RiscvEmulatorCSRRC(
 
     int32_t initialrs1value = *(uint32_t *)rs1;
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_CSRRC);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "csrrc";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.rs1num = rs1num;
-    hc.rs1 = rs1;
-    hc.csrnum = csrnum;
-    hc.csr = csr;
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_CSRRC;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.rs1num = rs1num;
+        hc.rs1 = rs1;
+        hc.csrnum = csrnum;
+        hc.csr = csr;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum != 0) {
@@ -331,8 +412,10 @@ static inline void RiscvEmulatorCSRRC(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -347,19 +430,24 @@ static inline void RiscvEmulatorCSRRCI(
     const uint16_t csrnum __attribute__((unused)),
     const void *csr) {
 
+    RiscvEmulatorHistogram(state, HOOK_INSTRUCTION_CSRRCI);
+
 #if (RVE_E_HOOK == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "csrrci";
-    hc.hook = HOOK_BEGIN;
-    hc.rdnum = rdnum;
-    hc.rd = rd;
-    hc.imm = uimm;
-    hc.csrnum = csrnum;
-    hc.csr = csr;
-    hc.immlength = sizeof(uimm);
-    hc.immname = "uimm";
-    RiscvEmulatorHook(state, &hc);
+    RiscvEmulatorHookContext_t hc;
+    if (state->hookmask & HOOK_MASK_INSTRUCTION) {
+        state->hookexists = 1;
+        memset(&hc, 0, sizeof(hc));
+        hc.instruction = HOOK_INSTRUCTION_CSRRCI;
+        hc.hook = HOOK_BEGIN;
+        hc.rdnum = rdnum;
+        hc.rd = rd;
+        hc.imm = uimm;
+        hc.csrnum = csrnum;
+        hc.csr = csr;
+        hc.immlength = sizeof(uimm);
+        hc.immname = HOOK_IMMEDIATE_UIMM;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 
     if (rdnum != 0) {
@@ -372,8 +460,10 @@ static inline void RiscvEmulatorCSRRCI(
     }
 
 #if (RVE_E_HOOK == 1)
-    hc.hook = HOOK_END;
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookexists) {
+        hc.hook = HOOK_END;
+        RiscvEmulatorCallHook(state, &hc);
+    }
 #endif
 }
 
@@ -0,0 +1,77 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorExtensionZihpm_H_
+#define RiscvEmulatorExtensionZihpm_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_ZIHPM == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * Get the 64-bit value of mhpmcounter3..31.
+ */
+static inline uint64_t RiscvEmulatorZihpmCounter(const RiscvEmulatorState_t *state, const uint8_t index) {
+    return state->eventcount[state->mhpmevent[index]] + state->mhpmoffset[index];
+}
+
+/**
+ * Get a performance monitoring CSR into state->counter.
+ *
+ * @return 0 when csr is not a performance monitoring CSR.
+ */
+static inline void *RiscvEmulatorZihpmRead(RiscvEmulatorState_t *state, const uint16_t csr) {
+    uint8_t number = csr & 0x1F;
+    if (number < 3) {
+        return 0;
+    }
+
+    // mhpmevent3..31
+    if ((csr & 0xFE0) == 0x320) {
+        state->counter = state->mhpmevent[number - 3];
+        return &state->counter;
+    }
+
+    // mhpmcounter3..31, hpmcounter3..31 and their high halves.
+    if ((csr & 0xF60) == 0xB00 || (csr & 0xF60) == 0xC00) {
+        uint64_t value = RiscvEmulatorZihpmCounter(state, number - 3);
+        state->counter = (csr & 0x80) ? (uint32_t)(value >> 32) : (uint32_t)value;
+        return &state->counter;
+    }
+
+    return 0;
+}
+
+/**
+ * Write state->counter back to mhpmcounter3..31, their high halves or mhpmevent3..31.
+ *
+ * Selecting another event keeps the value of the counter.
+ */
+static inline void RiscvEmulatorZihpmWrite(RiscvEmulatorState_t *state, const uint16_t csr) {
+    uint8_t index = (csr & 0x1F) - 3;
+    uint64_t value = RiscvEmulatorZihpmCounter(state, index);
+
+    if ((csr & 0xFE0) == 0x320) {
+        // Unknown events count nothing.
+        state->mhpmevent[index] = state->counter < EVENT_COUNT ? (uint8_t)state->counter : EVENT_NONE;
+    } else if (csr & 0x80) {
+        value = ((uint64_t)state->counter << 32) | (uint32_t)value;
+    } else {
+        value = (value & 0xFFFFFFFF00000000) | state->counter;
+    }
+
+    state->mhpmoffset[index] = value - state->eventcount[state->mhpmevent[index]];
+}
+
+#endif
+
+#endif
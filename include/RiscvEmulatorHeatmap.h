@@ -0,0 +1,136 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorHeatmap_H_
+#define RiscvEmulatorHeatmap_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_HEATMAP == 1)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * Clear a heatmap before attaching it to an instance with state->heatmap.
+ *
+ * @param origin Address of the first cache line counted, RVE_HEATMAP_LINES cache lines are counted from there.
+ */
+static inline void RiscvEmulatorHeatmapInit(RiscvEmulatorHeatmap_t *heatmap, uint32_t origin) {
+    heatmap->origin = origin & ~((UINT32_C(1) << RVE_HEATMAP_LINE_SHIFT) - 1);
+    heatmap->outsideread = 0;
+    heatmap->outsidewrite = 0;
+    memset(heatmap->read, 0, sizeof(heatmap->read));
+    memset(heatmap->write, 0, sizeof(heatmap->write));
+}
+
+/**
+ * Count a load of the instruction being executed.
+ */
+static inline void RiscvEmulatorHeatmapLoad(RiscvEmulatorState_t *state, uint32_t address) {
+    RiscvEmulatorHeatmap_t *heatmap = state->heatmap;
+    if (heatmap == 0) {
+        return;
+    }
+
+    uint32_t line = (address - heatmap->origin) >> RVE_HEATMAP_LINE_SHIFT;
+    if (line < RVE_HEATMAP_LINES) {
+        heatmap->read[line]++;
+    } else {
+        heatmap->outsideread++;
+    }
+}
+
+/**
+ * Count a store of the instruction being executed.
+ */
+static inline void RiscvEmulatorHeatmapStore(RiscvEmulatorState_t *state, uint32_t address) {
+    RiscvEmulatorHeatmap_t *heatmap = state->heatmap;
+    if (heatmap == 0) {
+        return;
+    }
+
+    uint32_t line = (address - heatmap->origin) >> RVE_HEATMAP_LINE_SHIFT;
+    if (line < RVE_HEATMAP_LINES) {
+        heatmap->write[line]++;
+    } else {
+        heatmap->outsidewrite++;
+    }
+}
+
+/**
+ * Total the accesses of a block of memory, for example a page.
+ *
+ * @param address Start of the block, aligned to its size.
+ * @param shift Size of the block as a power of 2, at least RVE_HEATMAP_LINE_SHIFT.
+ */
+static inline void RiscvEmulatorHeatmapTotal(
+    const RiscvEmulatorHeatmap_t *heatmap,
+    uint32_t address,
+    uint8_t shift,
+    uint64_t *read,
+    uint64_t *write) {
+    *read = 0;
+    *write = 0;
+
+    uint32_t first = (address - heatmap->origin) >> RVE_HEATMAP_LINE_SHIFT;
+    uint32_t count = UINT32_C(1) << (shift - RVE_HEATMAP_LINE_SHIFT);
+    for (uint32_t line = first; line - first < count && line < RVE_HEATMAP_LINES; line++) {
+        *read += heatmap->read[line];
+        *write += heatmap->write[line];
+    }
+}
+
+static inline uint32_t RiscvEmulatorHeatmapDecimal(char *buffer, uint64_t value) {
+    char digit[20];
+    uint32_t count = 0;
+    do {
+        digit[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    for (uint32_t index = 0; index < count; index++) {
+        buffer[index] = digit[count - 1 - index];
+    }
+    return count;
+}
+
+/**
+ * Write the accesses of a block of memory as a line of CSV: address, reads and writes.
+ *
+ * @param shift Size of the block as a power of 2, see RiscvEmulatorHeatmapTotal().
+ * @param buffer Room for HEATMAP_ROW_LENGTH characters, always terminated by 0.
+ * @return The number of characters written, not counting the terminating 0.
+ */
+static inline uint32_t RiscvEmulatorHeatmapRow(const RiscvEmulatorHeatmap_t *heatmap, uint32_t address, uint8_t shift, char *buffer) {
+    uint64_t read;
+    uint64_t write;
+    RiscvEmulatorHeatmapTotal(heatmap, address, shift, &read, &write);
+
+    const char *digit = "0123456789abcdef";
+    uint32_t written = 0;
+    buffer[written++] = '0';
+    buffer[written++] = 'x';
+    for (uint8_t nibble = 0; nibble < 8; nibble++) {
+        buffer[written++] = digit[(address >> (28 - nibble * 4)) & 0xf];
+    }
+
+    buffer[written++] = ',';
+    written += RiscvEmulatorHeatmapDecimal(&buffer[written], read);
+    buffer[written++] = ',';
+    written += RiscvEmulatorHeatmapDecimal(&buffer[written], write);
+
+    buffer[written] = 0;
+    return written;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorHistogram_H_
+#define RiscvEmulatorHistogram_H_
+
+#include <stdint.h>
+
+#include "RiscvEmulatorConfig.h"
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * Count an execution of the instruction.
+ *
+ * Compiles to nothing without RVE_E_HISTOGRAM.
+ *
+ * @param instruction One of HOOK_INSTRUCTION_*.
+ */
+static inline void RiscvEmulatorHistogram(RiscvEmulatorState_t *state __attribute__((unused)), const uint8_t instruction __attribute__((unused))) {
+#if (RVE_E_HISTOGRAM == 1)
+#if (RVE_E_ASYNC == 1)
+    // Counted when the instruction suspended, not again when it is executed again after RiscvEmulatorResume().
+    if (state->pending.kind == PENDING_COMPLETED) {
+        return;
+    }
+#endif
+
+    state->histogram[instruction]++;
+#endif
+}
+
+#if (RVE_E_HISTOGRAM == 1)
+/**
+ * List the instructions executed at least once, most executed first. Their counts are in state->histogram.
+ *
+ * @param instruction Room for HOOK_INSTRUCTION_COUNT numbers, filled with HOOK_INSTRUCTION_*.
+ * @return The number of instructions listed.
+ */
+static inline uint8_t RiscvEmulatorHistogramSort(const RiscvEmulatorState_t *state, uint8_t *instruction) {
+    uint8_t count = 0;
+
+    for (uint8_t hookinstruction = 0; hookinstruction < HOOK_INSTRUCTION_COUNT; hookinstruction++) {
+        if (state->histogram[hookinstruction] == 0) {
+            continue;
+        }
+
+        uint8_t index = count++;
+        while (index > 0 && state->histogram[instruction[index - 1]] < state->histogram[hookinstruction]) {
+            instruction[index] = instruction[index - 1];
+            index--;
+        }
+        instruction[index] = hookinstruction;
+    }
+
+    return count;
+}
+#endif
+
+#endif
@@ -26,4 +26,24 @@ __attribute__((weak)) void RiscvEmulatorHook(
 
 #pragma GCC diagnostic pop
 
+#if (RVE_E_HOOK == 1)
+/**
+ * Call the hook when state->hookmask subscribes to context->hook.
+ */
+static inline void RiscvEmulatorCallHook(
+    const RiscvEmulatorState_t *state,
+    const RiscvEmulatorHookContext_t *context) {
+#if (RVE_E_ASYNC == 1)
+    // Begun when the load suspended, only ended when it is executed again after RiscvEmulatorResume().
+    if (context->hook == HOOK_BEGIN && state->pending.kind == PENDING_COMPLETED) {
+        return;
+    }
+#endif
+
+    if (state->hookmask & (1 << context->hook)) {
+        RiscvEmulatorHook(state, context);
+    }
+}
+#endif
+
 #endif
@@ -0,0 +1,72 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorIdle_H_
+#define RiscvEmulatorIdle_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_IDLE == 1)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RiscvEmulatorBudget.h"
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * Remember that the instruction being executed has an effect outside the registers.
+ */
+static inline void RiscvEmulatorIdleSideEffect(RiscvEmulatorState_t *state) {
+    state->idlesideeffect = 1;
+}
+
+/**
+ * Look at a backward jump or branch, parking the hart like WFI when its loop does nothing.
+ *
+ * Every RVE_IDLE_ITERATIONS arrivals at the same jump the registers are compared with the previous time. When they are
+ * equal and nothing but loads happened, the loop will spin until an interrupt arrives or a polled device changes.
+ * With RVE_E_SMP only jumps to themselves are considered, as other harts can change memory.
+ */
+static inline void RiscvEmulatorIdleBranch(RiscvEmulatorState_t *state) {
+#if (RVE_E_SMP == 1)
+    if (state->programcounternext != state->programcounter) {
+        return;
+    }
+#endif
+
+    // Not a loop when an instruction is executed again after suspending or stopping.
+    if (state->exitreason != EXIT_REASON_NONE) {
+        return;
+    }
+
+    if (state->idlebranch != state->programcounter) {
+        state->idlebranch = state->programcounter;
+        state->idlecount = 0;
+        state->idlesideeffect = 1;
+        return;
+    }
+
+    if (++state->idlecount < RVE_IDLE_ITERATIONS) {
+        return;
+    }
+    state->idlecount = 0;
+
+    if (state->idlesideeffect == 0 && memcmp(&state->reg, &state->idlereg, sizeof(state->reg)) == 0) {
+        state->waiting = 1;
+        RiscvEmulatorEndChunk(state);
+        return;
+    }
+
+    state->idlesideeffect = 0;
+    memcpy(&state->idlereg, &state->reg, sizeof(state->reg));
+}
+
+#endif
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorInterrupt_H_
+#define RiscvEmulatorInterrupt_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_INTERRUPT == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulatorBudget.h"
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorEvent.h"
+#include "RiscvEmulatorHook.h"
+#include "RiscvEmulatorType.h"
+#include "RiscvEmulatorTypeSmp.h"
+
+/**
+ * Make RiscvEmulatorRun() look for an interrupt to take after the instruction being executed.
+ */
+static inline void RiscvEmulatorAttention(RiscvEmulatorState_t *state) {
+    state->attention = 1;
+    RiscvEmulatorEndChunk(state);
+}
+
+/**
+ * Raise or clear interrupts in mip, for example MIP_MEIP from a device of the implementation.
+ *
+ * @param mask MIP_* bits to change.
+ */
+static inline void RiscvEmulatorSetInterruptPending(RiscvEmulatorState_t *state, uint32_t mask, uint8_t pending) {
+    if (pending) {
+        state->csr.mip.mip |= mask;
+    } else {
+        state->csr.mip.mip &= ~mask;
+    }
+
+    RiscvEmulatorAttention(state);
+
+    // Waking up from WFI.
+    if (state->exitreason == EXIT_REASON_WFI) {
+        state->exitreason = EXIT_REASON_NONE;
+    }
+}
+
+/**
+ * Wake up from WFI or an idle loop, for example after the state of a device polled by the guest changed.
+ */
+static inline void RiscvEmulatorWake(RiscvEmulatorState_t *state) {
+    state->waiting = 0;
+
+    if (state->exitreason == EXIT_REASON_WFI) {
+        state->exitreason = EXIT_REASON_NONE;
+    }
+}
+
+/**
+ * Let time pass while waiting for an interrupt.
+ *
+ * Called by RiscvEmulatorRun() between chunks. When the only way out of WFI is the machine timer, mtime jumps straight
+ * to mtimecmp instead of executing the chunks in between.
+ *
+ * With RVE_E_SMP mtime is shared, so it only jumps when all other harts wait or exited as well, and then to the first
+ * deadline of any of them.
+ */
+static inline void RiscvEmulatorWaitSkip(RiscvEmulatorState_t *state) {
+#if (RVE_E_CLINT == 1)
+    uint64_t mtimecmp = __atomic_load_n(&state->mtimecmp, __ATOMIC_RELAXED);
+    if ((state->csr.mip.mip & state->csr.mie.mie) == 0 &&
+        (state->csr.mie.mie & MIP_MTIP) != 0 &&
+        mtimecmp != UINT64_MAX) {
+        uint64_t local = state->retired + state->mtimeoffset;
+        uint64_t mtime = local;
+#if (RVE_E_SMP == 1)
+        if (state->smp) {
+            for (uint8_t hartid = 0; hartid < state->smp->hartcount; hartid++) {
+                RiscvEmulatorState_t *other = &state->smp->hart[hartid];
+                if (other == state) {
+                    continue;
+                }
+
+                if (__atomic_load_n(&other->exitreason, __ATOMIC_RELAXED) == EXIT_REASON_NONE &&
+                    __atomic_load_n(&other->waiting, __ATOMIC_RELAXED) == 0) {
+                    return;
+                }
+
+                uint64_t othermtime = __atomic_load_n(&other->mtime, __ATOMIC_RELAXED);
+                if (othermtime > mtime) {
+                    mtime = othermtime;
+                }
+            }
+
+            for (uint8_t hartid = 0; hartid < state->smp->hartcount; hartid++) {
+                uint64_t othermtimecmp = __atomic_load_n(&state->smp->hart[hartid].mtimecmp, __ATOMIC_RELAXED);
+                if (othermtimecmp > mtime && othermtimecmp < mtimecmp) {
+                    mtimecmp = othermtimecmp;
+                }
+            }
+        }
+#endif
+        if (mtime < mtimecmp) {
+            state->mtimeoffset += mtimecmp - local;
+        }
+    }
+#else
+    (void)state;
+#endif
+}
+
+/**
+ * Wake up from WFI when an interrupt is pending and enabled in mie, even when it is not taken.
+ *
+ * @return 1 when still waiting.
+ */
+static inline uint8_t RiscvEmulatorWaiting(RiscvEmulatorState_t *state) {
+    if ((state->csr.mip.mip & state->csr.mie.mie) == 0) {
+        return 1;
+    }
+
+    state->waiting = 0;
+    return 0;
+}
+
+/**
+ * Take the interrupt with the highest priority when it is pending, enabled and interrupts are enabled in mstatus.
+ *
+ * Called by RiscvEmulatorRun() between chunks when state->attention is set, so no CSR is looked at per instruction.
+ */
+static inline void RiscvEmulatorInterrupt(RiscvEmulatorState_t *state) {
+#if (RVE_E_ASYNC == 1)
+    // The load executed again after RiscvEmulatorResume() goes first, the handler would find its value still pending.
+    if (state->pending.kind == PENDING_COMPLETED) {
+        state->chunk = 1;
+        return;
+    }
+#endif
+
+    state->attention = 0;
+
+    uint32_t pending = state->csr.mip.mip & state->csr.mie.mie;
+    if (state->csr.mstatus.mie == 0 || pending == 0) {
+        return;
+    }
+
+    uint32_t cause;
+    if (pending & MIP_MEIP) {
+        cause = MCAUSE_INTERRUPT_CODE_MACHINE_EXTERNAL;
+    } else if (pending & MIP_MSIP) {
+        cause = MCAUSE_INTERRUPT_CODE_MACHINE_SOFTWARE;
+    } else if (pending & MIP_MTIP) {
+        cause = MCAUSE_INTERRUPT_CODE_MACHINE_TIMER;
+    } else {
+        // Only supervisor interrupts, there is no supervisor mode.
+        return;
+    }
+
+    RiscvEmulatorEvent(state, EVENT_TRAP);
+
+    state->csr.mcause.interrupt = 1;
+    state->csr.mcause.exceptioncode = cause;
+
+    state->csr.mstatus.mpp = 3; // Previous privilege mode: M
+    state->csr.mstatus.mpie = state->csr.mstatus.mie;
+    state->csr.mstatus.mie = 0;
+
+    // Return to the instruction that was about to be executed.
+    state->csr.mepc = state->programcounternext;
+
+    state->programcounternext = state->csr.mtvec.base << 2;
+    // For mode 1, jump to the vector of the cause.
+    if (state->csr.mtvec.mode == 1) {
+        state->programcounternext += 4 * cause;
+    }
+
+#if (RVE_E_HOOK == 1)
+    if (state->hookmask & HOOK_MASK_INTERRUPT) {
+        state->hookexists = 1;
+        RiscvEmulatorHookContext_t hc = {0};
+        hc.hook = HOOK_INTERRUPT;
+        hc.instruction = HOOK_INSTRUCTION_INTERRUPT;
+        RiscvEmulatorHook(state, &hc);
+    }
+#endif
+
+#if (RVE_E_A == 1)
+    state->reservationvalid = 0;
+#endif
+}
+
+#endif
+
+#endif
@@ -0,0 +1,643 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorLockstep_H_
+#define RiscvEmulatorLockstep_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_LOCKSTEP == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulator.h"
+#include "RiscvEmulatorTypeBatch.h"
+
+/**
+ * Registers of a group of instances stored per lane, so an instruction is executed for all lanes by one loop the
+ * compiler can vectorize.
+ */
+typedef struct {
+    uint32_t x[32][RVE_LOCKSTEP_LANES];
+    uint32_t programcounternext[RVE_LOCKSTEP_LANES];
+
+    /**
+     * All bits set for lanes executing the current instruction.
+     */
+    uint32_t mask[RVE_LOCKSTEP_LANES];
+
+    /**
+     * Instructions retired per lane, not counting instructions executed by RiscvEmulatorRun().
+     */
+    uint32_t retired[RVE_LOCKSTEP_LANES];
+
+    uint8_t active[RVE_LOCKSTEP_LANES];
+    RiscvEmulatorBatchJob_t *job;
+    uint8_t lanecount;
+} RiscvEmulatorLockstep_t;
+
+/**
+ * Copy registers of a lane to the state of its instance.
+ */
+static inline void RiscvEmulatorLockstepScatter(RiscvEmulatorLockstep_t *lockstep, uint8_t lane) {
+    RiscvEmulatorState_t *state = lockstep->job[lane].state;
+
+    for (uint8_t regnum = 1; regnum < 32; regnum++) {
+        state->reg.x[regnum] = lockstep->x[regnum][lane];
+    }
+    state->programcounternext = lockstep->programcounternext[lane];
+    state->retired += lockstep->retired[lane];
+    lockstep->retired[lane] = 0;
+}
+
+/**
+ * Copy registers of the state of an instance to its lane.
+ */
+static inline void RiscvEmulatorLockstepGather(RiscvEmulatorLockstep_t *lockstep, uint8_t lane) {
+    RiscvEmulatorState_t *state = lockstep->job[lane].state;
+
+    for (uint8_t regnum = 0; regnum < 32; regnum++) {
+        lockstep->x[regnum][lane] = state->reg.x[regnum];
+    }
+    lockstep->programcounternext[lane] = state->programcounternext;
+}
+
+/**
+ * Stop a lane when its instance exited or reached its instruction limit.
+ */
+static inline void RiscvEmulatorLockstepCheck(RiscvEmulatorLockstep_t *lockstep, uint8_t lane) {
+    RiscvEmulatorBatchJob_t *job = &lockstep->job[lane];
+
+    if (job->state->exitreason != EXIT_REASON_NONE) {
+        job->exitreason = job->state->exitreason;
+        lockstep->active[lane] = 0;
+    } else if (job->limit > 0 && job->state->retired + lockstep->retired[lane] >= job->limit) {
+        job->exitreason = EXIT_REASON_LIMIT;
+        lockstep->active[lane] = 0;
+    }
+}
+
+/**
+ * Execute the current instruction of a single lane with the regular emulator.
+ */
+static inline void RiscvEmulatorLockstepScalar(RiscvEmulatorLockstep_t *lockstep, uint8_t lane) {
+    RiscvEmulatorLockstepScatter(lockstep, lane);
+
+    RiscvEmulatorBatchMemory = lockstep->job[lane].memory;
+    RiscvEmulatorRun(lockstep->job[lane].state, 1);
+
+    RiscvEmulatorLockstepGather(lockstep, lane);
+    RiscvEmulatorLockstepCheck(lockstep, lane);
+}
+
+/**
+ * Calculate an R-type operation for all lanes.
+ *
+ * @return 0 when the operation is not supported.
+ */
+static inline uint8_t RiscvEmulatorLockstepOperation(
+    uint32_t *result,
+    const uint32_t *rs1,
+    const uint32_t *rs2,
+    uint16_t funct7_3) {
+
+    switch (funct7_3) {
+        case FUNCT7_FUNCT3_OPERATION_ADD:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] + rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_SUB:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] - rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_SLL:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] << (rs2[lane] & 0b11111);
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_SLT:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = (int32_t)rs1[lane] < (int32_t)rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_SLTU:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] < rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_XOR:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] ^ rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_SRL:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] >> (rs2[lane] & 0b11111);
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_SRA:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = (int32_t)rs1[lane] >> (rs2[lane] & 0b11111);
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_OR:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] | rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_AND:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] & rs2[lane];
+            }
+            return 1;
+#if (RVE_E_M == 1)
+        case FUNCT7_FUNCT3_OPERATION_MUL:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] * rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_MULH:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = ((int64_t)(int32_t)rs1[lane] * (int64_t)(int32_t)rs2[lane]) >> 32;
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_MULHSU:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = ((int64_t)(int32_t)rs1[lane] * (int64_t)rs2[lane]) >> 32;
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_MULHU:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = ((uint64_t)rs1[lane] * (uint64_t)rs2[lane]) >> 32;
+            }
+            return 1;
+#endif
+#if (RVE_E_ZBB == 1)
+        case FUNCT7_FUNCT3_OPERATION_ANDN:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] & ~rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_ORN:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] | ~rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_XNOR:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = ~(rs1[lane] ^ rs2[lane]);
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_MIN:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = (int32_t)rs1[lane] < (int32_t)rs2[lane] ? rs1[lane] : rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_MAX:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = (int32_t)rs1[lane] > (int32_t)rs2[lane] ? rs1[lane] : rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_MINU:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] < rs2[lane] ? rs1[lane] : rs2[lane];
+            }
+            return 1;
+        case FUNCT7_FUNCT3_OPERATION_MAXU:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = rs1[lane] > rs2[lane] ? rs1[lane] : rs2[lane];
+            }
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Calculate the branch condition for all lanes, 1 when taken.
+ *
+ * @return 0 when the branch is not supported.
+ */
+static inline uint8_t RiscvEmulatorLockstepCondition(
+    uint32_t *taken,
+    const uint32_t *rs1,
+    const uint32_t *rs2,
+    uint8_t funct3) {
+
+    switch (funct3) {
+        case FUNCT3_BRANCH_BEQ:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                taken[lane] = rs1[lane] == rs2[lane];
+            }
+            return 1;
+        case FUNCT3_BRANCH_BNE:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                taken[lane] = rs1[lane] != rs2[lane];
+            }
+            return 1;
+        case FUNCT3_BRANCH_BLT:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                taken[lane] = (int32_t)rs1[lane] < (int32_t)rs2[lane];
+            }
+            return 1;
+        case FUNCT3_BRANCH_BGE:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                taken[lane] = (int32_t)rs1[lane] >= (int32_t)rs2[lane];
+            }
+            return 1;
+        case FUNCT3_BRANCH_BLTU:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                taken[lane] = rs1[lane] < rs2[lane];
+            }
+            return 1;
+        case FUNCT3_BRANCH_BGEU:
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                taken[lane] = rs1[lane] >= rs2[lane];
+            }
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Write a result to a register of the lanes executing the current instruction.
+ */
+static inline void RiscvEmulatorLockstepWrite(RiscvEmulatorLockstep_t *lockstep, uint8_t rdnum, const uint32_t *result) {
+    if (rdnum == 0) {
+        return;
+    }
+
+    uint32_t *rd = lockstep->x[rdnum];
+    for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+        rd[lane] = (result[lane] & lockstep->mask[lane]) | (rd[lane] & ~lockstep->mask[lane]);
+    }
+}
+
+/**
+ * Advance the lanes executing the current instruction, taking the jump where taken is set.
+ */
+static inline void RiscvEmulatorLockstepAdvance(RiscvEmulatorLockstep_t *lockstep, const uint32_t *taken, uint32_t programcounter, uint32_t jumptoprogramcounter) {
+    for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+        uint32_t next = taken[lane] ? jumptoprogramcounter : programcounter + 4;
+        lockstep->programcounternext[lane] = (next & lockstep->mask[lane]) | (lockstep->programcounternext[lane] & ~lockstep->mask[lane]);
+        lockstep->retired[lane] += lockstep->mask[lane] & 1;
+    }
+}
+
+/**
+ * Execute a load or store for each lane executing the current instruction.
+ *
+ * Lanes accessing memory misaligned are executed by the regular emulator, so they trap like it does.
+ *
+ * @return 0 when the instruction is not supported.
+ */
+static inline uint8_t RiscvEmulatorLockstepMemory(RiscvEmulatorLockstep_t *lockstep, RiscvInstruction_u instruction) {
+#if (RVE_E_ASYNC == 1)
+    // Any lane can suspend, the regular emulator handles that.
+    (void)lockstep;
+    (void)instruction;
+    return 0;
+#endif
+
+    uint8_t store = instruction.opcode == OPCODE32_STORE;
+    uint8_t length;
+    int16_t offset;
+
+    if (store) {
+        RiscvInstructionTypeSDecoderImm_u immdecoder = {0};
+        immdecoder.bit.imm4_0 = instruction.stype.imm4_0;
+        immdecoder.bit.imm11_5 = instruction.stype.imm11_5;
+        offset = immdecoder.imm;
+
+        switch (instruction.stype.funct3) {
+            case FUNCT3_STORE_SB:
+                length = sizeof(uint8_t);
+                break;
+            case FUNCT3_STORE_SH:
+                length = sizeof(uint16_t);
+                break;
+            case FUNCT3_STORE_SW:
+                length = sizeof(uint32_t);
+                break;
+            default:
+                return 0;
+        }
+    } else {
+        offset = instruction.itype.imm;
+
+        switch (instruction.itype.funct3) {
+            case FUNCT3_LOAD_LB:
+            case FUNCT3_LOAD_LBU:
+                length = sizeof(uint8_t);
+                break;
+            case FUNCT3_LOAD_LH:
+            case FUNCT3_LOAD_LHU:
+                length = sizeof(uint16_t);
+                break;
+            case FUNCT3_LOAD_LW:
+                length = sizeof(uint32_t);
+                break;
+            default:
+                return 0;
+        }
+    }
+
+    for (uint8_t lane = 0; lane < lockstep->lanecount; lane++) {
+        if (lockstep->mask[lane] == 0) {
+            continue;
+        }
+
+        uint32_t memorylocation = lockstep->x[instruction.stype.rs1][lane] + offset;
+
+#if (RVE_E_ZICSR == 1)
+        if ((memorylocation % length) != 0) {
+            RiscvEmulatorLockstepScalar(lockstep, lane);
+            continue;
+        }
+#endif
+
+        RiscvEmulatorBatchMemory = lockstep->job[lane].memory;
+
+        if (store) {
+            RiscvEmulatorOpsStore(lockstep->job[lane].state, memorylocation, &lockstep->x[instruction.stype.rs2][lane], length);
+        } else if (instruction.itype.rd != 0) {
+            uint32_t value = 0;
+            RiscvEmulatorOpsLoad(lockstep->job[lane].state, memorylocation, &value, length);
+
+            switch (instruction.itype.funct3) {
+                case FUNCT3_LOAD_LB:
+                    value = (int8_t)value;
+                    break;
+                case FUNCT3_LOAD_LH:
+                    value = (int16_t)value;
+                    break;
+            }
+
+            lockstep->x[instruction.itype.rd][lane] = value;
+        }
+
+        lockstep->programcounternext[lane] += 4;
+        lockstep->retired[lane]++;
+    }
+
+    return 1;
+}
+
+/**
+ * Execute an instruction for all lanes executing it.
+ *
+ * @return 0 when the instruction must be executed by the regular emulator.
+ */
+static inline uint8_t RiscvEmulatorLockstepExecute(RiscvEmulatorLockstep_t *lockstep, RiscvInstruction_u instruction, uint32_t programcounter) {
+    static const uint32_t nottaken[RVE_LOCKSTEP_LANES] = {0};
+    uint32_t result[RVE_LOCKSTEP_LANES];
+    uint32_t operand[RVE_LOCKSTEP_LANES];
+
+    switch (instruction.opcode) {
+        case OPCODE32_OPERATION: {
+            RiscvInstructionTypeRDecoderFunct7Funct3_u decoder = {0};
+            decoder.funct3 = instruction.rtype.funct3;
+            decoder.funct7 = instruction.rtype.funct7;
+
+            if (!RiscvEmulatorLockstepOperation(result, lockstep->x[instruction.rtype.rs1], lockstep->x[instruction.rtype.rs2], decoder.funct7_3)) {
+                return 0;
+            }
+
+            RiscvEmulatorLockstepWrite(lockstep, instruction.rtype.rd, result);
+            RiscvEmulatorLockstepAdvance(lockstep, nottaken, programcounter, 0);
+            return 1;
+        }
+        case OPCODE32_IMMEDIATE: {
+            // Map immediate instructions onto the matching R-type operation.
+            RiscvInstructionTypeRDecoderFunct7Funct3_u decoder = {0};
+            decoder.funct3 = instruction.itype.funct3;
+
+            if (instruction.itype.funct3 == FUNCT3_IMMEDIATE_FUNCTIONS_1 ||
+                instruction.itype.funct3 == FUNCT3_IMMEDIATE_FUNCTIONS_5) {
+                // Only plain shifts, the other functions in this group are executed by the regular emulator.
+                RiscvInstructionTypeIDecoderImm11_7Funct3Imm11_7Funct3_u immdecoder = {0};
+                immdecoder.funct3 = instruction.itype.funct3;
+                immdecoder.imm11_5 = instruction.itypeshiftbyconstant.imm11_5;
+
+                switch (immdecoder.imm11_5funct3) {
+                    case IMM11_5_FUNCT3_IMMEDIATE_SLLI:
+                    case IMM11_5_FUNCT3_IMMEDIATE_SRLI:
+                    case IMM11_5_FUNCT3_IMMEDIATE_SRAI:
+                        decoder.funct7 = immdecoder.imm11_5;
+                        break;
+                    default:
+                        return 0;
+                }
+            } else if (instruction.itype.funct3 == FUNCT3_IMMEDIATE_ADDI) {
+                // Not a subtraction.
+                decoder.funct7 = 0;
+            }
+
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                operand[lane] = (int32_t)instruction.itype.imm;
+            }
+
+            if (!RiscvEmulatorLockstepOperation(result, lockstep->x[instruction.itype.rs1], operand, decoder.funct7_3)) {
+                return 0;
+            }
+
+            RiscvEmulatorLockstepWrite(lockstep, instruction.itype.rd, result);
+            RiscvEmulatorLockstepAdvance(lockstep, nottaken, programcounter, 0);
+            return 1;
+        }
+        case OPCODE32_LOADUPPERIMMEDIATE:
+        case OPCODE32_ADDUPPERIMMEDIATE2PC: {
+            RiscvInstructionTypeUDecoderImm_u immdecoder = {0};
+            immdecoder.bit.imm31_12 = instruction.utype.imm31_12;
+
+            uint32_t value = immdecoder.imm;
+            if (instruction.opcode == OPCODE32_ADDUPPERIMMEDIATE2PC) {
+                value += programcounter;
+            }
+
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = value;
+            }
+
+            RiscvEmulatorLockstepWrite(lockstep, instruction.utype.rd, result);
+            RiscvEmulatorLockstepAdvance(lockstep, nottaken, programcounter, 0);
+            return 1;
+        }
+        case OPCODE32_BRANCH: {
+            RiscvInstructionTypeBDecoderImm_u immdecoder = {0};
+            immdecoder.bit.imm4_1 = instruction.btype.imm4_1;
+            immdecoder.bit.imm10_5 = instruction.btype.imm10_5;
+            immdecoder.bit.imm11 = instruction.btype.imm11;
+            immdecoder.bit.imm12 = instruction.btype.imm12;
+            uint32_t jumptoprogramcounter = programcounter + immdecoder.imm;
+
+#if (RVE_E_ZICSR == 1) && (RVE_E_C != 1)
+            // Let the regular emulator trap.
+            if ((jumptoprogramcounter & 0b11) != 0) {
+                return 0;
+            }
+#endif
+
+            if (!RiscvEmulatorLockstepCondition(result, lockstep->x[instruction.btype.rs1], lockstep->x[instruction.btype.rs2], instruction.btype.funct3)) {
+                return 0;
+            }
+
+            RiscvEmulatorLockstepAdvance(lockstep, result, programcounter, jumptoprogramcounter);
+            return 1;
+        }
+        case OPCODE32_JUMPANDLINK: {
+            RiscvInstructionTypeJDecoderImm_u immdecoder = {0};
+            immdecoder.bit.imm10_1 = instruction.jtype.imm10_1;
+            immdecoder.bit.imm11 = instruction.jtype.imm11;
+            immdecoder.bit.imm19_12 = instruction.jtype.imm19_12;
+            immdecoder.bit.imm20 = instruction.jtype.imm20;
+            uint32_t jumptoprogramcounter = programcounter + immdecoder.imm;
+
+#if (RVE_E_ZICSR == 1) && (RVE_E_C != 1)
+            // Let the regular emulator trap.
+            if ((jumptoprogramcounter & 0b11) != 0) {
+                return 0;
+            }
+#endif
+
+            for (uint8_t lane = 0; lane < RVE_LOCKSTEP_LANES; lane++) {
+                result[lane] = programcounter + 4;
+                operand[lane] = 1;
+            }
+
+            RiscvEmulatorLockstepWrite(lockstep, instruction.jtype.rd, result);
+            RiscvEmulatorLockstepAdvance(lockstep, operand, programcounter, jumptoprogramcounter);
+            return 1;
+        }
+        case OPCODE32_LOAD:
+        case OPCODE32_STORE:
+            return RiscvEmulatorLockstepMemory(lockstep, instruction);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Run a group of batch jobs executing the same code in lockstep.
+ *
+ * Every step the lanes with the lowest program counter execute the instruction found there together. Lanes that took
+ * a different branch wait until the others catch up with them, which regroups lanes once they meet again. Compressed
+ * instructions, system instructions and anything else not supported here are executed per lane by the regular
+ * emulator.
+ *
+ * @param lanecount The number of jobs, at most RVE_LOCKSTEP_LANES.
+ * @param count The number of steps to execute.
+ * @return The number of jobs still running.
+ */
+static inline uint8_t RiscvEmulatorLockstepRun(RiscvEmulatorBatchJob_t *job, uint8_t lanecount, uint32_t count) {
+    RiscvEmulatorLockstep_t lockstep = {0};
+    lockstep.job = job;
+    lockstep.lanecount = lanecount > RVE_LOCKSTEP_LANES ? RVE_LOCKSTEP_LANES : lanecount;
+
+    for (uint8_t lane = 0; lane < lockstep.lanecount; lane++) {
+        RiscvEmulatorLockstepGather(&lockstep, lane);
+        job[lane].exitreason = EXIT_REASON_NONE;
+        lockstep.active[lane] = 1;
+        RiscvEmulatorLockstepCheck(&lockstep, lane);
+    }
+
+    for (uint32_t step = 0; step < count; step++) {
+        // Find the lanes executing the next instruction.
+        uint8_t leader = RVE_LOCKSTEP_LANES;
+        for (uint8_t lane = 0; lane < lockstep.lanecount; lane++) {
+            if (lockstep.active[lane] &&
+                (leader == RVE_LOCKSTEP_LANES || lockstep.programcounternext[lane] < lockstep.programcounternext[leader])) {
+                leader = lane;
+            }
+        }
+
+        if (leader == RVE_LOCKSTEP_LANES) {
+            break;
+        }
+
+        uint32_t programcounter = lockstep.programcounternext[leader];
+        for (uint8_t lane = 0; lane < lockstep.lanecount; lane++) {
+            lockstep.mask[lane] = (lockstep.active[lane] && lockstep.programcounternext[lane] == programcounter) ? UINT32_MAX : 0;
+        }
+
+        RiscvInstruction_u instruction = {0};
+        RiscvEmulatorBatchMemory = job[leader].memory;
+        RiscvEmulatorOpsFetch(job[leader].state, programcounter, &instruction.value, sizeof(instruction.value));
+
+        // Hooks, traces, profiles, caches, predictors and the histogram expect every instruction to go through the regular emulator.
+        // So do interrupts, the CLINT and performance counters, which are handled by RiscvEmulatorRun() between chunks.
+#if (RVE_E_HISTOGRAM == 1) || (RVE_E_INTERRUPT == 1) || (RVE_E_CLINT == 1) || (RVE_E_ZIHPM == 1)
+        uint8_t scalar = 1;
+#else
+        uint8_t scalar = 0;
+#endif
+        for (uint8_t lane = 0; lane < lockstep.lanecount; lane++) {
+            if (lockstep.mask[lane] == 0) {
+                continue;
+            }
+#if (RVE_E_HOOK == 1)
+            if (job[lane].state->hookmask & HOOK_MASK_INSTRUCTION) {
+                scalar = 1;
+            }
+#endif
+#if (RVE_E_TRACE == 1)
+            if (job[lane].state->trace) {
+                scalar = 1;
+            }
+#endif
+#if (RVE_E_PROFILE == 1)
+            if (job[lane].state->profile) {
+                scalar = 1;
+            }
+#endif
+#if (RVE_E_CACHE == 1)
+            if (job[lane].state->icache || job[lane].state->dcache) {
+                scalar = 1;
+            }
+#endif
+#if (RVE_E_PREDICTOR == 1)
+            if (job[lane].state->predictor) {
+                scalar = 1;
+            }
+#endif
+        }
+
+        uint8_t executed = 0;
+        // A compressed instruction has the lowest 2 bits not set to 0b11.
+        if (scalar == 0 && (instruction.value & 0b11) == 0b11) {
+            executed = RiscvEmulatorLockstepExecute(&lockstep, instruction, programcounter);
+        }
+
+        for (uint8_t lane = 0; lane < lockstep.lanecount; lane++) {
+            if (lockstep.mask[lane] == 0) {
+                continue;
+            }
+
+            if (executed) {
+                RiscvEmulatorLockstepCheck(&lockstep, lane);
+            } else {
+                RiscvEmulatorLockstepScalar(&lockstep, lane);
+            }
+        }
+    }
+
+    uint8_t running = 0;
+    for (uint8_t lane = 0; lane < lockstep.lanecount; lane++) {
+        RiscvEmulatorLockstepScatter(&lockstep, lane);
+        running += lockstep.active[lane];
+    }
+
+    return running;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,240 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorOps_H_
+#define RiscvEmulatorOps_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_OPS != 1)
+#include <RiscvEmulatorImplementationSpecific.h>
+#endif
+
+#include "RiscvEmulatorAsync.h"
+#include "RiscvEmulatorCache.h"
+#include "RiscvEmulatorClint.h"
+#include "RiscvEmulatorEvent.h"
+#include "RiscvEmulatorHeatmap.h"
+#include "RiscvEmulatorIdle.h"
+#include "RiscvEmulatorTrace.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * Fetch an instruction from memory of the instance.
+ */
+static inline void RiscvEmulatorOpsFetch(RiscvEmulatorState_t *state, uint32_t address, void *destination, uint8_t length) {
+#if (RVE_E_OPS == 1)
+    state->ops->load(state, address, destination, length);
+#else
+    (void)state;
+    RiscvEmulatorLoad(address, destination, length);
+#endif
+}
+
+/**
+ * Load from memory of the instance, the CLINT or a completed asynchronous load.
+ */
+static inline void RiscvEmulatorOpsLoadMemory(RiscvEmulatorState_t *state, uint32_t address, void *destination, uint8_t length) {
+#if (RVE_E_CLINT == 1)
+    if (address - CLINT_ORIGIN < CLINT_LENGTH) {
+        RiscvEmulatorClintLoad(state, address, destination, length);
+        return;
+    }
+#endif
+
+#if (RVE_E_ASYNC == 1)
+    if (RiscvEmulatorAsyncCompleted(state, address, destination, length)) {
+        return;
+    }
+
+    uint32_t value = 0;
+    state->ops->load(state, address, &value, length);
+
+    if (state->pending.kind == PENDING_SUSPENDED) {
+        RiscvEmulatorAsyncPending(state, PENDING_LOAD, address, 0, length);
+        return;
+    }
+
+    memcpy(destination, &value, length);
+#elif (RVE_E_OPS == 1)
+    state->ops->load(state, address, destination, length);
+#else
+    (void)state;
+    RiscvEmulatorLoad(address, destination, length);
+#endif
+}
+
+/**
+ * Count a load or store of the instruction being executed in the events, heatmap, data cache and trace.
+ *
+ * Called by RiscvEmulatorOpsLoad() and RiscvEmulatorOpsStore(), and with RVE_E_SMP by atomic memory operations
+ * executed with host atomics, which access RAM directly.
+ *
+ * @param memoryaccess TRACE_MEMORY_LOAD or TRACE_MEMORY_STORE.
+ * @param value The value loaded or stored.
+ */
+static inline void RiscvEmulatorOpsObserve(
+    RiscvEmulatorState_t *state,
+    uint8_t memoryaccess __attribute__((unused)),
+    uint32_t address __attribute__((unused)),
+    const void *value __attribute__((unused)),
+    uint8_t length __attribute__((unused))) {
+#if (RVE_E_ASYNC == 1)
+    // Counted when the load is executed again.
+    if (state->pending.kind == PENDING_LOAD) {
+        return;
+    }
+#endif
+
+    if (memoryaccess == TRACE_MEMORY_LOAD) {
+        RiscvEmulatorEvent(state, EVENT_LOAD);
+#if (RVE_E_HEATMAP == 1)
+        RiscvEmulatorHeatmapLoad(state, address);
+#endif
+#if (RVE_E_CACHE == 1)
+        RiscvEmulatorCacheLoad(state, address, length);
+#endif
+    } else {
+        RiscvEmulatorEvent(state, EVENT_STORE);
+#if (RVE_E_HEATMAP == 1)
+        RiscvEmulatorHeatmapStore(state, address);
+#endif
+#if (RVE_E_CACHE == 1)
+        RiscvEmulatorCacheStore(state, address, length);
+#endif
+    }
+
+#if (RVE_E_TRACE == 1)
+    RiscvEmulatorTraceMemory(state, memoryaccess, address, value, length);
+#endif
+}
+
+/**
+ * Load from memory of the instance.
+ */
+static inline void RiscvEmulatorOpsLoad(RiscvEmulatorState_t *state, uint32_t address, void *destination, uint8_t length) {
+    RiscvEmulatorOpsLoadMemory(state, address, destination, length);
+    RiscvEmulatorOpsObserve(state, TRACE_MEMORY_LOAD, address, destination, length);
+}
+
+/**
+ * Store to memory of the instance.
+ */
+static inline void RiscvEmulatorOpsStore(RiscvEmulatorState_t *state, uint32_t address, const void *source, uint8_t length) {
+    RiscvEmulatorOpsObserve(state, TRACE_MEMORY_STORE, address, source, length);
+
+#if (RVE_E_IDLE == 1)
+    RiscvEmulatorIdleSideEffect(state);
+#endif
+
+#if (RVE_E_CLINT == 1)
+    if (address - CLINT_ORIGIN < CLINT_LENGTH) {
+        RiscvEmulatorClintStore(state, address, source, length);
+        return;
+    }
+#endif
+
+#if (RVE_E_OPS == 1)
+    state->ops->store(state, address, source, length);
+
+#if (RVE_E_ASYNC == 1)
+    if (state->pending.kind == PENDING_SUSPENDED) {
+        RiscvEmulatorAsyncPending(state, PENDING_STORE, address, source, length);
+    }
+#endif
+#else
+    (void)state;
+    RiscvEmulatorStore(address, source, length);
+#endif
+}
+
+/**
+ * Handle an illegal instruction of the instance.
+ */
+static inline void RiscvEmulatorOpsIllegalInstruction(RiscvEmulatorState_t *state) {
+#if (RVE_E_IDLE == 1)
+    RiscvEmulatorIdleSideEffect(state);
+#endif
+
+#if (RVE_E_OPS == 1)
+    state->ops->illegalinstruction(state);
+#else
+    RiscvEmulatorIllegalInstruction(state);
+#endif
+}
+
+#if (RVE_E_ZICSR == 1)
+/**
+ * Handle an unknown CSR of the instance.
+ */
+static inline void RiscvEmulatorOpsUnknownCSR(RiscvEmulatorState_t *state) {
+#if (RVE_E_IDLE == 1)
+    RiscvEmulatorIdleSideEffect(state);
+#endif
+
+#if (RVE_E_OPS == 1)
+    state->ops->unknowncsr(state);
+#else
+    RiscvEmulatorUnknownCSR(state);
+#endif
+}
+#endif
+
+/**
+ * Handle an ECALL of the instance.
+ */
+static inline void RiscvEmulatorOpsHandleECALL(RiscvEmulatorState_t *state) {
+#if (RVE_E_IDLE == 1)
+    RiscvEmulatorIdleSideEffect(state);
+#endif
+
+#if (RVE_E_OPS == 1)
+    state->ops->handleecall(state);
+
+#if (RVE_E_ASYNC == 1)
+    if (state->pending.kind == PENDING_SUSPENDED) {
+        RiscvEmulatorAsyncPending(state, PENDING_ECALL, 0, 0, 0);
+    }
+#endif
+#else
+    RiscvEmulatorHandleECALL(state);
+#endif
+}
+
+/**
+ * Handle an EBREAK of the instance.
+ */
+static inline void RiscvEmulatorOpsHandleEBREAK(RiscvEmulatorState_t *state) {
+#if (RVE_E_IDLE == 1)
+    RiscvEmulatorIdleSideEffect(state);
+#endif
+
+#if (RVE_E_OPS == 1)
+    state->ops->handleebreak(state);
+#else
+    RiscvEmulatorHandleEBREAK(state);
+#endif
+}
+
+#if (RVE_E_SMP == 1)
+/**
+ * Get the host address of RAM of the instance.
+ */
+static inline void *RiscvEmulatorOpsHostAddress(RiscvEmulatorState_t *state, uint32_t address) {
+#if (RVE_E_OPS == 1)
+    return state->ops->hostaddress(state, address);
+#else
+    (void)state;
+    return RiscvEmulatorHostAddress(address);
+#endif
+}
+#endif
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorPredictor_H_
+#define RiscvEmulatorPredictor_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RiscvEmulatorConfig.h"
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+#if (RVE_E_PREDICTOR == 1)
+#if (RVE_PREDICTOR_PROGRAMCOUNTERS & (RVE_PREDICTOR_PROGRAMCOUNTERS - 1)) != 0
+#error "RVE_PREDICTOR_PROGRAMCOUNTERS must be a power of 2"
+#endif
+
+/**
+ * Prepare a branch predictor before attaching it to an instance with state->predictor.
+ *
+ * @param kind One of PREDICTOR_*.
+ * @param countercount Number of 2-bit counters, a power of 2.
+ * @param targetcount Number of entries of the branch target buffer, a power of 2.
+ * @param returncount Number of entries of the return address stack.
+ * @return 1 when the predictor fits in RVE_PREDICTOR_COUNTERS, RVE_PREDICTOR_TARGETS and RVE_PREDICTOR_RETURNS.
+ */
+static inline uint8_t RiscvEmulatorPredictorInit(
+    RiscvEmulatorPredictor_t *predictor,
+    uint8_t kind,
+    uint32_t countercount,
+    uint32_t targetcount,
+    uint32_t returncount) {
+    if (countercount == 0 || (countercount & (countercount - 1)) != 0 || countercount > RVE_PREDICTOR_COUNTERS ||
+        targetcount == 0 || (targetcount & (targetcount - 1)) != 0 || targetcount > RVE_PREDICTOR_TARGETS ||
+        returncount > RVE_PREDICTOR_RETURNS) {
+        return 0;
+    }
+
+    predictor->kind = kind;
+    predictor->history = 0;
+    predictor->countercount = countercount;
+    predictor->targetcount = targetcount;
+    predictor->returncount = returncount;
+    predictor->returndepth = 0;
+    predictor->returntop = 0;
+    predictor->branches = 0;
+    predictor->branchmisses = 0;
+    predictor->indirects = 0;
+    predictor->indirectmisses = 0;
+    predictor->returns = 0;
+    predictor->returnmisses = 0;
+    predictor->targetmisses = 0;
+    predictor->overflow = 0;
+
+    // Weakly not taken.
+    memset(predictor->counter, 1, sizeof(predictor->counter));
+    memset(predictor->target, 0, sizeof(predictor->target));
+    memset(predictor->programcounter, 0, sizeof(predictor->programcounter));
+    return 1;
+}
+
+/**
+ * Count the execution of the branch or jump at programcounter.
+ */
+static inline void RiscvEmulatorPredictorCount(RiscvEmulatorPredictor_t *predictor, uint32_t programcounter, uint8_t taken, uint8_t mispredicted) {
+    uint32_t slot = ((programcounter >> 1) * UINT32_C(0x9e3779b1)) & (RVE_PREDICTOR_PROGRAMCOUNTERS - 1);
+    // A few slots only, a full table would otherwise be searched for every new branch.
+    for (uint32_t probe = 0; probe < RVE_PREDICTOR_PROBES && probe < RVE_PREDICTOR_PROGRAMCOUNTERS; probe++) {
+        RiscvEmulatorPredictorProgramCounter_t *entry = &predictor->programcounter[(slot + probe) & (RVE_PREDICTOR_PROGRAMCOUNTERS - 1)];
+        if (entry->programcounter == programcounter || entry->executed == 0) {
+            entry->programcounter = programcounter;
+            entry->executed++;
+            entry->taken += taken;
+            entry->mispredicted += mispredicted;
+            return;
+        }
+    }
+
+    predictor->overflow++;
+}
+
+/**
+ * Look up the target of the taken branch or jump at programcounter in the branch target buffer, and remember target.
+ *
+ * @return 1 when the branch target buffer had target.
+ */
+static inline uint8_t RiscvEmulatorPredictorTarget(RiscvEmulatorPredictor_t *predictor, uint32_t programcounter, uint32_t target) {
+    RiscvEmulatorPredictorTarget_t *entry = &predictor->target[(programcounter >> 1) & (predictor->targetcount - 1)];
+    uint8_t hit = entry->valid && entry->programcounter == programcounter && entry->target == target;
+
+    entry->programcounter = programcounter;
+    entry->target = target;
+    entry->valid = 1;
+    return hit;
+}
+
+/**
+ * List the branches and jumps, most mispredicted first.
+ *
+ * @param index Room for RVE_PREDICTOR_PROGRAMCOUNTERS numbers, filled with indexes in predictor->programcounter.
+ * @return The number of branches and jumps listed.
+ */
+static inline uint32_t RiscvEmulatorPredictorSort(const RiscvEmulatorPredictor_t *predictor, uint32_t *index) {
+    uint32_t count = 0;
+
+    for (uint32_t entry = 0; entry < RVE_PREDICTOR_PROGRAMCOUNTERS; entry++) {
+        if (predictor->programcounter[entry].executed == 0) {
+            continue;
+        }
+
+        uint32_t position = count++;
+        while (position > 0 && predictor->programcounter[index[position - 1]].mispredicted < predictor->programcounter[entry].mispredicted) {
+            index[position] = index[position - 1];
+            position--;
+        }
+        index[position] = entry;
+    }
+
+    return count;
+}
+#endif
+
+/**
+ * Predict the direction of the conditional branch being executed, then train the predictor with its outcome.
+ *
+ * Compiles to nothing without RVE_E_PREDICTOR.
+ *
+ * @param target Destination when taken.
+ */
+static inline void RiscvEmulatorPredictorBranch(
+    RiscvEmulatorState_t *state __attribute__((unused)),
+    const uint8_t taken __attribute__((unused)),
+    const uint32_t target __attribute__((unused))) {
+#if (RVE_E_PREDICTOR == 1)
+    RiscvEmulatorPredictor_t *predictor = state->predictor;
+    if (predictor == 0) {
+        return;
+    }
+
+    uint32_t slot = state->programcounter >> 1;
+    if (predictor->kind == PREDICTOR_GSHARE) {
+        slot ^= predictor->history;
+    }
+    uint8_t *counter = &predictor->counter[slot & (predictor->countercount - 1)];
+
+    uint8_t mispredicted = (*counter >= 2) != taken;
+    predictor->branches++;
+    predictor->branchmisses += mispredicted;
+
+    if (taken) {
+        if (*counter < 3) {
+            (*counter)++;
+        }
+        if (RiscvEmulatorPredictorTarget(predictor, state->programcounter, target) == 0) {
+            predictor->targetmisses++;
+        }
+    } else if (*counter > 0) {
+        (*counter)--;
+    }
+    predictor->history = (predictor->history << 1) | taken;
+
+    RiscvEmulatorPredictorCount(predictor, state->programcounter, taken, mispredicted);
+#endif
+}
+
+/**
+ * Predict the destination of the jump being executed with the branch target buffer, or the return address stack for a
+ * return. Calls and returns are recognized by the link register, x1 or x5.
+ *
+ * Compiles to nothing without RVE_E_PREDICTOR.
+ *
+ * @param rdnum Register receiving the return address, 0 when not linking.
+ * @param rs1num Register holding the destination, 0 for JAL.
+ */
+static inline void RiscvEmulatorPredictorJump(
+    RiscvEmulatorState_t *state __attribute__((unused)),
+    const uint8_t rdnum __attribute__((unused)),
+    const uint8_t rs1num __attribute__((unused)),
+    const uint32_t jumptoprogramcounter __attribute__((unused))) {
+#if (RVE_E_PREDICTOR == 1)
+    RiscvEmulatorPredictor_t *predictor = state->predictor;
+    if (predictor == 0) {
+        return;
+    }
+
+    uint8_t rdlink = (rdnum == 1 || rdnum == 5);
+    uint8_t rs1link = (rs1num == 1 || rs1num == 5);
+    uint8_t mispredicted = 0;
+
+    if (rs1num == 0) {
+        // Direct, the destination is known once decoded.
+        if (RiscvEmulatorPredictorTarget(predictor, state->programcounter, jumptoprogramcounter) == 0) {
+            predictor->targetmisses++;
+        }
+    } else if (rs1link && (rdlink == 0 || rdnum != rs1num)) {
+        // Return, or a coroutine swap returning and calling at once.
+        uint32_t predicted = 0;
+        if (predictor->returndepth > 0) {
+            predicted = predictor->returnaddress[predictor->returntop];
+            predictor->returntop = (predictor->returntop + predictor->returncount - 1) % predictor->returncount;
+            predictor->returndepth--;
+        }
+
+        mispredicted = (predicted != jumptoprogramcounter);
+        predictor->returns++;
+        predictor->returnmisses += mispredicted;
+        RiscvEmulatorPredictorCount(predictor, state->programcounter, 1, mispredicted);
+    } else {
+        mispredicted = (RiscvEmulatorPredictorTarget(predictor, state->programcounter, jumptoprogramcounter) == 0);
+        predictor->indirects++;
+        predictor->indirectmisses += mispredicted;
+        RiscvEmulatorPredictorCount(predictor, state->programcounter, 1, mispredicted);
+    }
+
+    // The oldest return address is overwritten when the stack is full.
+    if (rdlink && predictor->returncount > 0) {
+        uint8_t length = (state->instruction.value & 0b11) == 0b11 ? 4 : 2;
+        predictor->returntop = (predictor->returntop + 1) % predictor->returncount;
+        predictor->returnaddress[predictor->returntop] = state->programcounter + length;
+        if (predictor->returndepth < predictor->returncount) {
+            predictor->returndepth++;
+        }
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,394 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorProfile_H_
+#define RiscvEmulatorProfile_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RiscvEmulatorConfig.h"
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+#if (RVE_E_PROFILE == 1)
+static inline uint32_t RiscvEmulatorProfileRead32(const uint8_t *elf, uint32_t offset) {
+    uint32_t value;
+    memcpy(&value, &elf[offset], sizeof(value));
+    return value;
+}
+
+static inline uint16_t RiscvEmulatorProfileRead16(const uint8_t *elf, uint32_t offset) {
+    uint16_t value;
+    memcpy(&value, &elf[offset], sizeof(value));
+    return value;
+}
+
+/**
+ * Read the function symbols of a little-endian ELF32 file loaded in memory. Symbols with a name not ending inside
+ * their string table are skipped.
+ *
+ * @param symbol Room for count symbols, filled sorted by address.
+ * @return The number of symbols read, 0 when elf is not a little-endian ELF32 file or has no symbol table.
+ */
+static inline uint32_t RiscvEmulatorProfileElf(const uint8_t *elf, uint32_t length, RiscvEmulatorProfileSymbol_t *symbol, uint32_t count) {
+    if (length < PROFILE_ELF_HEADER_LENGTH ||
+        memcmp(elf, "\177ELF", 4) != 0 ||
+        elf[4] != PROFILE_ELF_CLASS32 ||
+        elf[5] != PROFILE_ELF_DATA2LSB) {
+        return 0;
+    }
+
+    uint32_t sectionoffset = RiscvEmulatorProfileRead32(elf, 0x20);
+    uint16_t sectionlength = RiscvEmulatorProfileRead16(elf, 0x2e);
+    uint16_t sectioncount = RiscvEmulatorProfileRead16(elf, 0x30);
+    if (sectionlength < PROFILE_ELF_SECTION_LENGTH ||
+        sectionoffset > length ||
+        (uint64_t)sectioncount * sectionlength > length - sectionoffset) {
+        return 0;
+    }
+
+    uint32_t symbolcount = 0;
+    for (uint16_t section = 0; section < sectioncount; section++) {
+        const uint32_t header = sectionoffset + section * sectionlength;
+        if (RiscvEmulatorProfileRead32(elf, header + 4) != PROFILE_ELF_SHT_SYMTAB) {
+            continue;
+        }
+
+        uint32_t tableoffset = RiscvEmulatorProfileRead32(elf, header + 16);
+        uint32_t tablelength = RiscvEmulatorProfileRead32(elf, header + 20);
+        uint32_t stringsection = RiscvEmulatorProfileRead32(elf, header + 24);
+        if (stringsection >= sectioncount || tableoffset > length || tablelength > length - tableoffset) {
+            continue;
+        }
+
+        const uint32_t stringheader = sectionoffset + stringsection * sectionlength;
+        uint32_t stringoffset = RiscvEmulatorProfileRead32(elf, stringheader + 16);
+        uint32_t stringlength = RiscvEmulatorProfileRead32(elf, stringheader + 20);
+        if (stringoffset > length || stringlength > length - stringoffset) {
+            continue;
+        }
+
+        for (uint32_t entry = tableoffset; entry + PROFILE_ELF_SYMBOL_LENGTH <= tableoffset + tablelength; entry += PROFILE_ELF_SYMBOL_LENGTH) {
+            uint32_t name = RiscvEmulatorProfileRead32(elf, entry);
+            uint8_t info = elf[entry + 12];
+            uint16_t sectionindex = RiscvEmulatorProfileRead16(elf, entry + 14);
+            if ((info & 0xf) != PROFILE_ELF_STT_FUNC || sectionindex == 0 || name >= stringlength || symbolcount == count) {
+                continue;
+            }
+
+            // The name must end inside the string table.
+            if (memchr(&elf[stringoffset + name], 0, stringlength - name) == 0) {
+                continue;
+            }
+
+            RiscvEmulatorProfileSymbol_t function;
+            function.address = RiscvEmulatorProfileRead32(elf, entry + 4);
+            function.size = RiscvEmulatorProfileRead32(elf, entry + 8);
+            function.name = (const char *)&elf[stringoffset + name];
+
+            // Insert sorted, symbol tables are mostly sorted already.
+            uint32_t index = symbolcount++;
+            while (index > 0 && symbol[index - 1].address > function.address) {
+                symbol[index] = symbol[index - 1];
+                index--;
+            }
+            symbol[index] = function;
+        }
+    }
+
+    return symbolcount;
+}
+
+/**
+ * Prepare a profile before attaching it to an instance with state->profile.
+ *
+ * @param interval Number of instructions between samples, larger than 0.
+ * @param symbol Function symbols sorted by address, or 0 to only follow calls.
+ */
+static inline void RiscvEmulatorProfileInit(
+    RiscvEmulatorProfile_t *profile,
+    uint32_t interval,
+    const RiscvEmulatorProfileSymbol_t *symbol,
+    uint32_t symbolcount) {
+    profile->interval = interval;
+    profile->countdown = interval;
+    profile->timer = 0;
+    profile->pending = 0;
+    profile->current = PROFILE_NODE_ROOT;
+    profile->mark = 0;
+    profile->overflow = 0;
+    profile->depth = 0;
+    profile->deepest = 0;
+    profile->stackpointer = UINT32_MAX;
+    profile->stacknode = PROFILE_NODE_ROOT;
+    profile->samples = 0;
+    profile->symbol = symbol;
+    profile->symbolcount = symbolcount;
+
+    profile->nodecount = 1;
+    memset(&profile->node[PROFILE_NODE_ROOT], 0, sizeof(profile->node[PROFILE_NODE_ROOT]));
+}
+
+/**
+ * Take a sample at the end of the current interval, when profile->timer is set. Safe to call from a signal handler.
+ */
+static inline void RiscvEmulatorProfileTimer(RiscvEmulatorProfile_t *profile) {
+    __atomic_store_n(&profile->pending, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * Returns the function containing address, or 0.
+ */
+static inline const RiscvEmulatorProfileSymbol_t *RiscvEmulatorProfileLookup(const RiscvEmulatorProfile_t *profile, uint32_t address) {
+    uint32_t low = 0;
+    uint32_t high = profile->symbolcount;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (profile->symbol[middle].address <= address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if (low == 0) {
+        return 0;
+    }
+
+    const RiscvEmulatorProfileSymbol_t *symbol = &profile->symbol[low - 1];
+    if (symbol->size != 0 && address - symbol->address >= symbol->size) {
+        return 0;
+    }
+    return symbol;
+}
+
+/**
+ * Returns the node of the function at address called from parent, added when it is not there yet.
+ *
+ * @return PROFILE_NODE_NONE when the call tree is full.
+ */
+static inline uint32_t RiscvEmulatorProfileChild(RiscvEmulatorProfile_t *profile, uint32_t parent, uint32_t address) {
+    for (uint32_t child = profile->node[parent].child; child != 0; child = profile->node[child].sibling) {
+        if (profile->node[child].address == address) {
+            return child;
+        }
+    }
+
+    if (profile->nodecount == RVE_PROFILE_NODES) {
+        return PROFILE_NODE_NONE;
+    }
+
+    uint32_t child = profile->nodecount++;
+    RiscvEmulatorProfileNode_t *node = &profile->node[child];
+    node->count = 0;
+    node->instructions = 0;
+    node->calls = 0;
+    node->address = address;
+    node->parent = parent;
+    node->child = 0;
+    node->sibling = profile->node[parent].child;
+    profile->node[parent].child = child;
+    return child;
+}
+
+/**
+ * Count a sample in the function being executed.
+ *
+ * Like instructions, a sample taken after a jump without a link register, like a tail call, counts in the function
+ * that jumped.
+ */
+static inline void RiscvEmulatorProfileSample(RiscvEmulatorProfile_t *profile) {
+    profile->node[profile->current].count++;
+    profile->samples++;
+}
+
+/**
+ * Write the functions leading to node separated by ';', as a line of folded stacks without its count.
+ *
+ * @param buffer Room for length characters, always terminated by 0.
+ * @return The number of characters written, not counting the terminating 0.
+ */
+static inline uint32_t RiscvEmulatorProfileFold(const RiscvEmulatorProfile_t *profile, uint32_t node, char *buffer, uint32_t length) {
+    uint32_t written = 0;
+
+    if (length == 0) {
+        return 0;
+    }
+
+    uint32_t depth = 0;
+    for (uint32_t parent = node; parent != PROFILE_NODE_ROOT; parent = profile->node[parent].parent) {
+        depth++;
+    }
+
+    if (depth == 0) {
+        const char *unknown = "[unknown]";
+        while (*unknown != 0 && written + 1 < length) {
+            buffer[written++] = *unknown++;
+        }
+    }
+
+    // Outermost function first.
+    while (depth > 0) {
+        depth--;
+        uint32_t frame = node;
+        for (uint32_t level = 0; level < depth; level++) {
+            frame = profile->node[frame].parent;
+        }
+
+        if (written > 0 && written + 1 < length) {
+            buffer[written++] = ';';
+        }
+
+        uint32_t address = profile->node[frame].address;
+        const RiscvEmulatorProfileSymbol_t *symbol = RiscvEmulatorProfileLookup(profile, address);
+        if (symbol != 0) {
+            for (const char *name = symbol->name; *name != 0 && written + 1 < length; name++) {
+                buffer[written++] = *name;
+            }
+        } else {
+            const char *digit = "0123456789abcdef";
+            char hexadecimal[11] = {'0', 'x'};
+            for (uint8_t nibble = 0; nibble < 8; nibble++) {
+                hexadecimal[2 + nibble] = digit[(address >> (28 - nibble * 4)) & 0xf];
+            }
+            for (uint8_t index = 0; index < 10 && written + 1 < length; index++) {
+                buffer[written++] = hexadecimal[index];
+            }
+        }
+    }
+
+    buffer[written] = 0;
+    return written;
+}
+
+/**
+ * Total the instructions executed in the function at address over all the calls leading to it.
+ *
+ * @param exclusive Instructions executed in the function itself.
+ * @param inclusive Instructions executed in the function and the functions it called, recursive calls counted once.
+ */
+static inline void RiscvEmulatorProfileFunction(const RiscvEmulatorProfile_t *profile, uint32_t address, uint64_t *exclusive, uint64_t *inclusive) {
+    *exclusive = 0;
+    *inclusive = 0;
+
+    for (uint32_t node = 1; node < profile->nodecount; node++) {
+        if (profile->node[node].address == address) {
+            *exclusive += profile->node[node].instructions;
+        }
+
+        for (uint32_t parent = node; parent != PROFILE_NODE_ROOT; parent = profile->node[parent].parent) {
+            if (profile->node[parent].address == address) {
+                *inclusive += profile->node[node].instructions;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * End the chunk of RiscvEmulatorRun() at the next sample.
+ */
+static inline void RiscvEmulatorProfileChunk(RiscvEmulatorState_t *state) {
+    if (state->chunk > state->profile->countdown) {
+        state->chunk = state->profile->countdown;
+    }
+}
+
+/**
+ * Called by RiscvEmulatorRun() after every chunk.
+ */
+static inline void RiscvEmulatorProfileInterval(RiscvEmulatorState_t *state) {
+    RiscvEmulatorProfile_t *profile = state->profile;
+
+    profile->node[profile->current].instructions += state->chunk - profile->mark;
+    profile->mark = 0;
+
+    profile->countdown -= state->chunk;
+    if (profile->countdown > 0) {
+        return;
+    }
+    profile->countdown = profile->interval;
+
+    if (profile->timer == 0 || __atomic_exchange_n(&profile->pending, 0, __ATOMIC_RELAXED)) {
+        RiscvEmulatorProfileSample(profile);
+    }
+}
+#endif
+
+/**
+ * Follow a jump of the instruction being executed, recognizing calls and returns by the link register, x1 or x5.
+ * The instructions executed since the previous call or return are counted in the function left.
+ *
+ * Compiles to nothing without RVE_E_PROFILE.
+ *
+ * @param rdnum Register receiving the return address, 0 when not linking.
+ * @param rs1num Register holding the destination, 0 for JAL.
+ */
+static inline void RiscvEmulatorProfileJump(
+    RiscvEmulatorState_t *state __attribute__((unused)),
+    const uint8_t rdnum __attribute__((unused)),
+    const uint8_t rs1num __attribute__((unused)),
+    const uint32_t jumptoprogramcounter __attribute__((unused))) {
+#if (RVE_E_PROFILE == 1)
+    RiscvEmulatorProfile_t *profile = state->profile;
+    if (profile == 0) {
+        return;
+    }
+
+    uint8_t rdlink = (rdnum == 1 || rdnum == 5);
+    uint8_t rs1link = (rs1num == 1 || rs1num == 5);
+    if (rdlink == 0 && rs1link == 0) {
+        return;
+    }
+
+    // The jump itself is counted in the function it leaves.
+    uint32_t position = state->chunk - state->budget;
+    profile->node[profile->current].instructions += position - profile->mark;
+    profile->mark = position;
+
+    // Return, or a coroutine swap returning and calling at once.
+    if (rs1link && (rdlink == 0 || rdnum != rs1num)) {
+        if (profile->depth > 0) {
+            profile->depth--;
+        }
+
+        if (profile->overflow > 0) {
+            profile->overflow--;
+        } else if (profile->current != PROFILE_NODE_ROOT) {
+            profile->current = profile->node[profile->current].parent;
+        }
+    }
+
+    if (rdlink) {
+        uint32_t child = PROFILE_NODE_NONE;
+        if (profile->overflow == 0) {
+            child = RiscvEmulatorProfileChild(profile, profile->current, jumptoprogramcounter);
+        }
+
+        if (child == PROFILE_NODE_NONE) {
+            profile->overflow++;
+        } else {
+            profile->current = child;
+            profile->node[child].calls++;
+        }
+
+        profile->depth++;
+        if (profile->depth > profile->deepest) {
+            profile->deepest = profile->depth;
+        }
+
+        if (state->reg.sp < profile->stackpointer) {
+            profile->stackpointer = state->reg.sp;
+            profile->stacknode = profile->current;
+        }
+    }
+#endif
+}
+
+#endif
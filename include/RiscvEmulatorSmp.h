@@ -0,0 +1,258 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorSmp_H_
+#define RiscvEmulatorSmp_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_SMP == 1)
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+
+#include "RiscvEmulator.h"
+#include "RiscvEmulatorTypeSmp.h"
+
+/**
+ * Initialize all harts.
+ *
+ * Every hart starts at ROM_ORIGIN with the same stack pointer. Firmware is expected to read mhartid to give each hart its own stack.
+ *
+ * @param hartcount The number of harts, at most RVE_SMP_HARTS.
+ * @param ram_length The size in bytes of the RAM available.
+ */
+static inline void RiscvEmulatorSmpInit(RiscvEmulatorSmp_t *smp, uint8_t hartcount, uint32_t ram_length) {
+    if (hartcount > RVE_SMP_HARTS) {
+        hartcount = RVE_SMP_HARTS;
+    }
+
+    smp->hartcount = hartcount;
+    smp->quantum = RVE_SMP_QUANTUM;
+    smp->synchronized = 0;
+    smp->halted = 0;
+    smp->started = 0;
+    smp->threadcount = 0;
+    smp->stop = 0;
+
+    for (uint8_t hartid = 0; hartid < hartcount; hartid++) {
+        RiscvEmulatorInit(&smp->hart[hartid], ram_length);
+        smp->hart[hartid].smp = smp;
+
+#if (RVE_E_ZICSR == 1)
+        smp->hart[hartid].csr.mhartid.hartid = hartid;
+#endif
+    }
+}
+
+/**
+ * Check if all harts have exited. A hart parked in WFI has not, another hart can still wake it.
+ */
+static inline uint8_t RiscvEmulatorSmpExited(const RiscvEmulatorSmp_t *smp) {
+    for (uint8_t hartid = 0; hartid < smp->hartcount; hartid++) {
+        uint8_t exitreason = __atomic_load_n(&smp->hart[hartid].exitreason, __ATOMIC_RELAXED);
+        if (exitreason == EXIT_REASON_NONE || exitreason == EXIT_REASON_WFI) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * Run a hart for one quantum.
+ *
+ * A hart parked in WFI first looks again whether an interrupt is pending, its msip or mtimecmp may have been written by
+ * another hart. When none is, it stays parked without executing anything.
+ *
+ * @return The number of instructions executed.
+ */
+static inline uint32_t RiscvEmulatorSmpRunHart(RiscvEmulatorSmp_t *smp, RiscvEmulatorState_t *state) {
+    if (state->exitreason == EXIT_REASON_WFI) {
+        state->exitreason = EXIT_REASON_NONE;
+    }
+
+    return RiscvEmulatorRun(state, smp->quantum);
+}
+
+/**
+ * Thread executing a single hart until a stop is requested or the hart exits.
+ *
+ * When synchronized, all threads wait for each other after every quantum and stop at the same barrier. A hart parked in
+ * WFI keeps its thread, which yields the host CPU while it waits.
+ */
+static void *RiscvEmulatorSmpThread(void *argument) {
+    RiscvEmulatorSmp_t *smp = (RiscvEmulatorSmp_t *)argument;
+
+    // Claim the next hart.
+    uint8_t hartid = __atomic_fetch_add(&smp->started, 1, __ATOMIC_RELAXED);
+    RiscvEmulatorState_t *state = &smp->hart[hartid];
+
+    if (smp->synchronized == 0) {
+        while (__atomic_load_n(&smp->stop, __ATOMIC_RELAXED) == 0 &&
+               (state->exitreason == EXIT_REASON_NONE || state->exitreason == EXIT_REASON_WFI)) {
+            RiscvEmulatorSmpRunHart(smp, state);
+
+            if (state->exitreason == EXIT_REASON_WFI) {
+                sched_yield();
+            }
+        }
+
+        return 0;
+    }
+
+    uint8_t ready;
+    while ((ready = __atomic_load_n(&smp->ready, __ATOMIC_ACQUIRE)) == 0) {
+        sched_yield();
+    }
+
+    if (ready != 1) {
+        return 0;
+    }
+
+    for (;;) {
+        if (state->exitreason == EXIT_REASON_NONE || state->exitreason == EXIT_REASON_WFI) {
+            RiscvEmulatorSmpRunHart(smp, state);
+        }
+
+        // One thread decides for all of them, the stop flag can change while they pass the barrier.
+        if (pthread_barrier_wait(&smp->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            smp->halted = __atomic_load_n(&smp->stop, __ATOMIC_RELAXED) != 0 || RiscvEmulatorSmpExited(smp);
+        }
+        pthread_barrier_wait(&smp->barrier);
+
+        if (smp->halted) {
+            return 0;
+        }
+    }
+}
+
+/**
+ * Start a host thread for every hart.
+ *
+ * @param synchronized 0 to let harts run freely, 1 to let harts wait for each other after every quantum.
+ * @return 0 on success, otherwise the error of pthread_barrier_init() or pthread_create(). When free running, threads
+ * already started keep running. When synchronized, threads already started stop without running their hart. Either
+ * way smp->hartcount is left alone and RiscvEmulatorSmpJoin() joins the threads that did start.
+ */
+static inline int RiscvEmulatorSmpStart(RiscvEmulatorSmp_t *smp, uint8_t synchronized) {
+    smp->synchronized = synchronized;
+    smp->halted = 0;
+    smp->started = 0;
+    smp->threadcount = 0;
+
+    if (synchronized) {
+        int error = pthread_barrier_init(&smp->barrier, 0, smp->hartcount);
+        if (error != 0) {
+            // Leave RiscvEmulatorSmpJoin() no barrier to destroy.
+            smp->synchronized = 0;
+            return error;
+        }
+
+        // Threads wait until all of them exist, the barrier would never open for a thread that failed to start.
+        __atomic_store_n(&smp->ready, 0, __ATOMIC_RELAXED);
+        for (uint8_t hartid = 0; hartid < smp->hartcount; hartid++) {
+            error = pthread_create(&smp->thread[hartid], 0, RiscvEmulatorSmpThread, smp);
+            if (error != 0) {
+                __atomic_store_n(&smp->ready, 2, __ATOMIC_RELEASE);
+                return error;
+            }
+            smp->threadcount++;
+        }
+        __atomic_store_n(&smp->ready, 1, __ATOMIC_RELEASE);
+
+        return 0;
+    }
+
+    for (uint8_t hartid = 0; hartid < smp->hartcount; hartid++) {
+        int error = pthread_create(&smp->thread[hartid], 0, RiscvEmulatorSmpThread, smp);
+        if (error != 0) {
+            return error;
+        }
+        smp->threadcount++;
+    }
+
+    return 0;
+}
+
+/**
+ * Request all harts to stop, for example from RiscvEmulatorHandleECALL().
+ *
+ * Safe to call from any thread, including the threads executing the harts.
+ */
+static inline void RiscvEmulatorSmpRequestStop(RiscvEmulatorSmp_t *smp) {
+    __atomic_store_n(&smp->stop, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * Wait until all hart threads have stopped, also after RiscvEmulatorSmpStart() failed.
+ *
+ * Must not be called from a hart thread.
+ */
+static inline void RiscvEmulatorSmpJoin(RiscvEmulatorSmp_t *smp) {
+    for (uint8_t threadnum = 0; threadnum < smp->threadcount; threadnum++) {
+        pthread_join(smp->thread[threadnum], 0);
+    }
+    smp->threadcount = 0;
+
+    if (smp->synchronized) {
+        pthread_barrier_destroy(&smp->barrier);
+    }
+}
+
+/**
+ * Run all harts on the calling thread, one quantum at a time, until a stop is requested or all harts exited.
+ *
+ * Every round runs each hart for one quantum, in an order shuffled by a pseudo random generator. The same seed and
+ * quantum always give the same interleaving of harts, so a run can be repeated exactly while debugging.
+ *
+ * Also returns when a round executed nothing, all harts that have not exited are then parked in WFI waiting for the
+ * host, see RiscvEmulatorSetInterruptPending(). Calling it again continues the run.
+ *
+ * @param seed Seed of the pseudo random generator, 0 runs harts in order of their mhartid.
+ */
+static inline void RiscvEmulatorSmpRunDeterministic(RiscvEmulatorSmp_t *smp, uint32_t seed) {
+    uint8_t order[RVE_SMP_HARTS];
+    for (uint8_t hartid = 0; hartid < smp->hartcount; hartid++) {
+        order[hartid] = hartid;
+    }
+
+    smp->synchronized = 0;
+
+    while (smp->stop == 0 && !RiscvEmulatorSmpExited(smp)) {
+        if (seed != 0) {
+            // Fisher-Yates shuffle driven by xorshift32.
+            for (uint8_t i = smp->hartcount - 1; i > 0; i--) {
+                seed ^= seed << 13;
+                seed ^= seed >> 17;
+                seed ^= seed << 5;
+
+                uint8_t j = seed % (i + 1);
+                uint8_t hartid = order[i];
+                order[i] = order[j];
+                order[j] = hartid;
+            }
+        }
+
+        uint32_t executed = 0;
+        for (uint8_t i = 0; i < smp->hartcount && smp->stop == 0; i++) {
+            RiscvEmulatorState_t *state = &smp->hart[order[i]];
+            if (state->exitreason == EXIT_REASON_NONE || state->exitreason == EXIT_REASON_WFI) {
+                executed += RiscvEmulatorSmpRunHart(smp, state);
+            }
+        }
+
+        if (executed == 0 && smp->stop == 0) {
+            return;
+        }
+    }
+}
+
+#endif
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTrace_H_
+#define RiscvEmulatorTrace_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_TRACE == 1)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * Empty the ring buffer before attaching it to an instance with state->trace.
+ */
+static inline void RiscvEmulatorTraceInit(RiscvEmulatorTrace_t *trace) {
+    trace->head = 0;
+    trace->dropped = 0;
+    trace->tail = 0;
+}
+
+/**
+ * Remember a data memory access of the instruction being executed.
+ */
+static inline void RiscvEmulatorTraceMemory(
+    RiscvEmulatorState_t *state,
+    uint8_t memoryaccess,
+    uint32_t address,
+    const void *value,
+    uint8_t length) {
+    if (state->trace == 0) {
+        return;
+    }
+
+    RiscvEmulatorTraceRecord_t *record = &state->tracerecord;
+    record->memoryaccess = memoryaccess;
+    record->memorylocation = address;
+    record->memoryvalue = 0;
+    memcpy(&record->memoryvalue, value, length);
+    record->memorylength = length;
+}
+
+/**
+ * Returns the number of the register written by the instruction, or 0.
+ */
+static inline uint8_t RiscvEmulatorTraceRd(const RiscvInstruction_u *instruction) {
+#if (RVE_E_C == 1)
+    if (instruction->copcode.op != OPCODE16_QUADRANT_INVALID) {
+        RiscvInstructionTypeCDecoderOpcode_u decoderOpcode16 = {0};
+        decoderOpcode16.funct3 = instruction->copcode.funct3;
+        decoderOpcode16.op = instruction->copcode.op;
+
+        switch (decoderOpcode16.opfunct3) {
+            case OPCODE16_ADDI4SPN:
+                return instruction->ciwtype.rdp + 8;
+            case OPCODE16_LW:
+                return instruction->cltype.rdp + 8;
+            case OPCODE16_MISCALU:
+                return instruction->catype.rdp + 8;
+            case OPCODE16_ADDI:
+            case OPCODE16_LI:
+            case OPCODE16_LUI_ADDI16SP:
+            case OPCODE16_SLLI:
+                return instruction->citype.rd;
+            case OPCODE16_LWSP:
+                return instruction->cilwsp.rd;
+            case OPCODE16_JAL:
+                return 1;
+            case OPCODE16_JALR_MV_ADD:
+                if (instruction->crtype.rs2 != 0) {
+                    // C.MV and C.ADD.
+                    return instruction->crtype.rd;
+                }
+                if (instruction->crtype.funct4 == FUNCT4_ADD && instruction->crtype.rd != 0) {
+                    // C.JALR.
+                    return 1;
+                }
+                return 0;
+            default:
+                return 0;
+        }
+    }
+#endif
+
+    switch (instruction->opcode) {
+        case OPCODE32_OPERATION:
+        case OPCODE32_IMMEDIATE:
+        case OPCODE32_LOAD:
+        case OPCODE32_ADDUPPERIMMEDIATE2PC:
+        case OPCODE32_LOADUPPERIMMEDIATE:
+        case OPCODE32_JUMPANDLINK:
+        case OPCODE32_JUMPANDLINKREGISTER:
+#if (RVE_E_A == 1)
+        case OPCODE32_ATOMICMEMORYOPERATION:
+#endif
+            return instruction->itype.rd;
+        case OPCODE32_SYSTEM:
+            // CSR instructions.
+            if (instruction->itype.funct3 != 0) {
+                return instruction->itype.rd;
+            }
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Write the record of the executed instruction to the ring buffer.
+ */
+static inline void RiscvEmulatorTraceInstruction(RiscvEmulatorState_t *state) {
+#if (RVE_E_ASYNC == 1)
+    // The load is executed again when resumed.
+    if (state->pending.kind == PENDING_LOAD) {
+        state->tracerecord.memoryaccess = TRACE_MEMORY_NONE;
+        return;
+    }
+#endif
+
+    RiscvEmulatorTrace_t *trace = state->trace;
+    RiscvEmulatorTraceRecord_t *record = &state->tracerecord;
+    record->programcounter = state->programcounter;
+    record->instruction = state->instruction.value;
+    record->rdnum = RiscvEmulatorTraceRd(&state->instruction);
+    record->rdvalue = state->reg.x[record->rdnum];
+
+    uint32_t head = trace->head;
+    if (head - __atomic_load_n(&trace->tail, __ATOMIC_ACQUIRE) < RVE_TRACE_LENGTH) {
+        trace->record[head & (RVE_TRACE_LENGTH - 1)] = *record;
+        __atomic_store_n(&trace->head, head + 1, __ATOMIC_RELEASE);
+    } else {
+        __atomic_store_n(&trace->dropped, trace->dropped + 1, __ATOMIC_RELAXED);
+    }
+
+    record->memoryaccess = TRACE_MEMORY_NONE;
+}
+
+/**
+ * Read up to count records from the ring buffer, from a single host thread while the instance is running.
+ *
+ * @return The number of records read.
+ */
+static inline uint32_t RiscvEmulatorTraceRead(RiscvEmulatorTrace_t *trace, RiscvEmulatorTraceRecord_t *record, uint32_t count) {
+    uint32_t tail = trace->tail;
+    uint32_t available = __atomic_load_n(&trace->head, __ATOMIC_ACQUIRE) - tail;
+    if (count > available) {
+        count = available;
+    }
+
+    for (uint32_t recordnum = 0; recordnum < count; recordnum++) {
+        record[recordnum] = trace->record[(tail + recordnum) & (RVE_TRACE_LENGTH - 1)];
+    }
+
+    __atomic_store_n(&trace->tail, tail + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+#endif
+
+#endif
@@ -0,0 +1,225 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTraceCodec_H_
+#define RiscvEmulatorTraceCodec_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_TRACE == 1)
+
+#include <stdint.h>
+#include <string.h>
+
+#include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorTrace.h"
+#include "RiscvEmulatorType.h"
+
+/**
+ * Forget the previous records, done at every seek point.
+ */
+static inline void RiscvEmulatorTraceCodecReset(RiscvEmulatorTraceCodec_t *codec) {
+    codec->programcounter = 0;
+    codec->memorylocation = 0;
+    memset(codec->reg, 0, sizeof(codec->reg));
+    memset(codec->dictionary, 0, sizeof(codec->dictionary));
+}
+
+/**
+ * Prepare to encode a new trace, or to decode one from its start or from a seek point.
+ *
+ * @param count Number of the next record, a multiple of RVE_TRACE_SEEK_INTERVAL when decoding from a seek point.
+ */
+static inline void RiscvEmulatorTraceCodecInit(RiscvEmulatorTraceCodec_t *codec, uint32_t count) {
+    RiscvEmulatorTraceCodecReset(codec);
+    codec->count = count;
+}
+
+static inline uint32_t RiscvEmulatorTraceCodecSlot(uint32_t programcounter) {
+    return (programcounter >> 1) & (TRACE_CODEC_DICTIONARY_LENGTH - 1);
+}
+
+static inline uint8_t RiscvEmulatorTraceCodecLength(uint32_t instruction) {
+    return (instruction & 0x3) == 0x3 ? 4 : 2;
+}
+
+/**
+ * Write value in 7-bit groups, least significant first, with the top bit set when another group follows.
+ *
+ * @return The number of bytes written, at most 5.
+ */
+static inline uint8_t RiscvEmulatorTraceCodecPut(uint8_t *buffer, uint32_t value) {
+    uint8_t length = 0;
+    while (value >= 0x80) {
+        buffer[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[length++] = (uint8_t)value;
+    return length;
+}
+
+static inline uint8_t RiscvEmulatorTraceCodecGet(const uint8_t *buffer, uint32_t *value) {
+    uint8_t length = 0;
+    uint8_t shift = 0;
+    *value = 0;
+    do {
+        *value |= (uint32_t)(buffer[length] & 0x7f) << shift;
+        shift += 7;
+    } while (buffer[length++] & 0x80);
+    return length;
+}
+
+/**
+ * Write a difference with the sign in the lowest bit, so small negative differences are short as well.
+ */
+static inline uint8_t RiscvEmulatorTraceCodecPutDelta(uint8_t *buffer, uint32_t delta) {
+    return RiscvEmulatorTraceCodecPut(buffer, (delta << 1) ^ (uint32_t)((int32_t)delta >> 31));
+}
+
+static inline uint8_t RiscvEmulatorTraceCodecGetDelta(const uint8_t *buffer, uint32_t *delta) {
+    uint8_t length = RiscvEmulatorTraceCodecGet(buffer, delta);
+    *delta = (*delta >> 1) ^ (0 - (*delta & 1));
+    return length;
+}
+
+/**
+ * Encode a record read from the ring buffer.
+ *
+ * A record is a single byte of TRACE_CODEC_* flags followed by only what the decoder cannot derive from the previous
+ * records: the program counter when the previous instruction did not fall through, the instruction when it differs
+ * from the one last executed at its program counter, the register written when its value changed and the memory
+ * access with its address relative to the previous one.
+ *
+ * Every RVE_TRACE_SEEK_INTERVAL records the encoder forgets the previous records and starts the record with a seek
+ * point. Keep the offset in the output of every seek point to start decoding there later.
+ *
+ * @param buffer Room for TRACE_CODEC_LENGTH bytes.
+ * @return The number of bytes written.
+ */
+static inline uint8_t RiscvEmulatorTraceEncode(
+    RiscvEmulatorTraceCodec_t *codec,
+    const RiscvEmulatorTraceRecord_t *record,
+    uint8_t *buffer) {
+    uint8_t length = 0;
+
+    if (codec->count % RVE_TRACE_SEEK_INTERVAL == 0) {
+        RiscvEmulatorTraceCodecReset(codec);
+        buffer[length++] = TRACE_CODEC_SEEK;
+    }
+    codec->count++;
+
+    uint8_t *header = &buffer[length++];
+    *header = 0;
+
+    if (record->programcounter != codec->programcounter) {
+        *header |= TRACE_CODEC_JUMP;
+        length += RiscvEmulatorTraceCodecPutDelta(&buffer[length], record->programcounter - codec->programcounter);
+    }
+    codec->programcounter = record->programcounter + RiscvEmulatorTraceCodecLength(record->instruction);
+
+    uint32_t slot = RiscvEmulatorTraceCodecSlot(record->programcounter);
+    if (codec->dictionary[slot] == record->instruction) {
+        *header |= TRACE_CODEC_DICTIONARY;
+    } else {
+        codec->dictionary[slot] = record->instruction;
+        length += RiscvEmulatorTraceCodecPut(&buffer[length], record->instruction);
+    }
+
+    // The decoder finds the register written in the instruction.
+    if (record->rdnum != 0 && record->rdvalue != codec->reg[record->rdnum]) {
+        *header |= TRACE_CODEC_RD;
+        length += RiscvEmulatorTraceCodecPutDelta(&buffer[length], record->rdvalue - codec->reg[record->rdnum]);
+        codec->reg[record->rdnum] = record->rdvalue;
+    }
+
+    if (record->memoryaccess != TRACE_MEMORY_NONE) {
+        // Lengths 1, 2 and 4.
+        *header |= (uint8_t)(record->memoryaccess << TRACE_CODEC_MEMORY_SHIFT);
+        *header |= (uint8_t)((record->memorylength >> 1) << TRACE_CODEC_LENGTH_SHIFT);
+        length += RiscvEmulatorTraceCodecPutDelta(&buffer[length], record->memorylocation - codec->memorylocation);
+        codec->memorylocation = record->memorylocation;
+
+        if (record->rdnum != 0 && record->memoryvalue == record->rdvalue) {
+            *header |= TRACE_CODEC_MEMORYRDVALUE;
+        } else {
+            length += RiscvEmulatorTraceCodecPut(&buffer[length], record->memoryvalue);
+        }
+    }
+
+    return length;
+}
+
+/**
+ * Decode the next record, following the encoder.
+ *
+ * To read a trace as it is written, keep at least TRACE_CODEC_LENGTH bytes in buffer until the end of the trace. To
+ * start at a seek point, call RiscvEmulatorTraceCodecInit() with the number of its record first.
+ *
+ * @return The number of bytes read.
+ */
+static inline uint8_t RiscvEmulatorTraceDecode(
+    RiscvEmulatorTraceCodec_t *codec,
+    const uint8_t *buffer,
+    RiscvEmulatorTraceRecord_t *record) {
+    uint8_t length = 0;
+    uint32_t value;
+
+    uint8_t header = buffer[length++];
+    if (header == TRACE_CODEC_SEEK) {
+        RiscvEmulatorTraceCodecReset(codec);
+        header = buffer[length++];
+    }
+    codec->count++;
+
+    if (header & TRACE_CODEC_JUMP) {
+        length += RiscvEmulatorTraceCodecGetDelta(&buffer[length], &value);
+        codec->programcounter += value;
+    }
+    record->programcounter = codec->programcounter;
+
+    uint32_t slot = RiscvEmulatorTraceCodecSlot(record->programcounter);
+    if (header & TRACE_CODEC_DICTIONARY) {
+        record->instruction = codec->dictionary[slot];
+    } else {
+        length += RiscvEmulatorTraceCodecGet(&buffer[length], &record->instruction);
+        codec->dictionary[slot] = record->instruction;
+    }
+    codec->programcounter = record->programcounter + RiscvEmulatorTraceCodecLength(record->instruction);
+
+    RiscvInstruction_u instruction;
+    instruction.value = record->instruction;
+    record->rdnum = RiscvEmulatorTraceRd(&instruction);
+    if (header & TRACE_CODEC_RD) {
+        length += RiscvEmulatorTraceCodecGetDelta(&buffer[length], &value);
+        codec->reg[record->rdnum] += value;
+    }
+    record->rdvalue = codec->reg[record->rdnum];
+
+    record->memoryaccess = (header >> TRACE_CODEC_MEMORY_SHIFT) & TRACE_CODEC_MEMORY_MASK;
+    record->memorylength = 0;
+    record->memorylocation = 0;
+    record->memoryvalue = 0;
+    if (record->memoryaccess != TRACE_MEMORY_NONE) {
+        record->memorylength = (uint8_t)(1 << ((header >> TRACE_CODEC_LENGTH_SHIFT) & TRACE_CODEC_LENGTH_MASK));
+        length += RiscvEmulatorTraceCodecGetDelta(&buffer[length], &value);
+        codec->memorylocation += value;
+        record->memorylocation = codec->memorylocation;
+
+        if (header & TRACE_CODEC_MEMORYRDVALUE) {
+            record->memoryvalue = record->rdvalue;
+        } else {
+            length += RiscvEmulatorTraceCodecGet(&buffer[length], &record->memoryvalue);
+        }
+    }
+    record->reserved = 0;
+
+    return length;
+}
+
+#endif
+
+#endif
@@ -10,15 +10,18 @@
 
 #include <stdint.h>
 
-#include <RiscvEmulatorImplementationSpecific.h>
+#include "RiscvEmulatorOps.h"
 
 #include "RiscvEmulatorDefine.h"
+#include "RiscvEmulatorEvent.h"
 #include "RiscvEmulatorHook.h"
 
 /**
  * Handle a trap.
  */
 static inline void RiscvEmulatorTrap(RiscvEmulatorState_t *state) {
+    RiscvEmulatorEvent(state, EVENT_TRAP);
+
 #if (RVE_E_ZICSR == 1)
 
     // Instruction address misaligned
@@ -52,6 +55,8 @@ static inline void RiscvEmulatorTrap(RiscvEmulatorState_t *state) {
         state->csr.mtval = state->instruction.value;
     }
 
+    state->csr.mcause.interrupt = 0;
+
     state->csr.mstatus.mpp = 3; // Previous privilege mode: M
     state->csr.mstatus.mpie = state->csr.mstatus.mie;
     state->csr.mstatus.mie = 0;
@@ -66,16 +71,24 @@ static inline void RiscvEmulatorTrap(RiscvEmulatorState_t *state) {
 #endif
 
 #if (RVE_E_HOOK == 1 && RVE_E_ZICSR == 1)
-    state->hookexists = 1;
-    RiscvEmulatorHookContext_t hc = {0};
-    hc.instruction = "_trap";
-    RiscvEmulatorHook(state, &hc);
+    if (state->hookmask & HOOK_MASK_TRAP) {
+        state->hookexists = 1;
+        RiscvEmulatorHookContext_t hc = {0};
+        hc.hook = HOOK_TRAP;
+        hc.instruction = HOOK_INSTRUCTION_TRAP;
+        RiscvEmulatorHook(state, &hc);
+    }
 #endif
 
     if (state->trapflag.illegalinstruction == 1) {
-        RiscvEmulatorIllegalInstruction(state);
+        RiscvEmulatorOpsIllegalInstruction(state);
     }
 
+#if (RVE_E_A == 1)
+    // A trap between LR.W and SC.W makes SC.W fail.
+    state->reservationvalid = 0;
+#endif
+
     state->trapflag.value = 0;
 }
 
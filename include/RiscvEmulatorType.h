@@ -8,6 +8,8 @@
 #ifndef RiscvEmulatorType_H_
 #define RiscvEmulatorType_H_
 
+#include "RiscvEmulatorTypeBatch.h"
 #include "RiscvEmulatorTypeEmulator.h"
+#include "RiscvEmulatorTypeOps.h"
 
 #endif
@@ -0,0 +1,53 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTypeBatch_H_
+#define RiscvEmulatorTypeBatch_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_BATCH == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulatorTypeEmulator.h"
+
+/**
+ * A single instance run by RiscvEmulatorBatchRun().
+ */
+typedef struct {
+    /**
+     * Initialized state of the instance.
+     */
+    RiscvEmulatorState_t *state;
+
+    /**
+     * Memory of the instance, available to the implementation as RiscvEmulatorBatchMemory while it runs.
+     */
+    void *memory;
+
+    /**
+     * Maximum number of instructions to execute, 0 for no limit.
+     */
+    uint64_t limit;
+
+    /**
+     * Why the instance stopped, EXIT_REASON_LIMIT when it reached its limit.
+     */
+    uint8_t exitreason;
+} RiscvEmulatorBatchJob_t;
+
+/**
+ * Memory of the instance running on the current thread.
+ *
+ * Shared by all translation units, so it must be defined once in your implementation.
+ */
+extern __thread void *RiscvEmulatorBatchMemory;
+
+#endif
+
+#endif
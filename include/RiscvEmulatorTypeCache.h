@@ -0,0 +1,74 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTypeCache_H_
+#define RiscvEmulatorTypeCache_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_CACHE == 1)
+
+#include <stdint.h>
+
+typedef struct {
+    /**
+     * Address divided by the line size.
+     */
+    uint32_t tag;
+    uint8_t valid;
+    uint8_t dirty;
+
+    /**
+     * Access that last used the line for CACHE_POLICY_LRU, or filled it for CACHE_POLICY_FIFO.
+     */
+    uint64_t stamp;
+} RiscvEmulatorCacheLine_t;
+
+/**
+ * Hits and misses of the instruction at a program counter, both 0 when the entry is free.
+ */
+typedef struct {
+    uint32_t programcounter;
+    uint64_t hits;
+    uint64_t misses;
+} RiscvEmulatorCacheProgramCounter_t;
+
+/**
+ * A simulated set associative cache, see RiscvEmulatorCacheInit().
+ */
+typedef struct {
+    uint8_t lineshift;
+    uint8_t policy;
+    uint32_t sets;
+    uint32_t ways;
+
+    /**
+     * Number of accesses, and the state of CACHE_POLICY_RANDOM.
+     */
+    uint64_t clock;
+    uint32_t random;
+
+    uint64_t hits;
+    uint64_t misses;
+
+    /**
+     * Dirty lines replaced, each a write to memory in a write-back cache.
+     */
+    uint64_t writebacks;
+
+    /**
+     * Accesses of program counters not in the table because it was full.
+     */
+    uint64_t overflow;
+
+    RiscvEmulatorCacheLine_t line[RVE_CACHE_LINES];
+    RiscvEmulatorCacheProgramCounter_t programcounter[RVE_CACHE_PROGRAMCOUNTERS];
+} RiscvEmulatorCache_t;
+
+#endif
+
+#endif
@@ -12,9 +12,35 @@
 
 #include "RiscvEmulatorConfig.h"
 
+#include "RiscvEmulatorDefineEvent.h"
+#include "RiscvEmulatorDefineHook.h"
 #include "RiscvEmulatorTypeCSR.h"
+#include "RiscvEmulatorTypeCache.h"
+#include "RiscvEmulatorTypeHeatmap.h"
 #include "RiscvEmulatorTypeInstruction.h"
+#include "RiscvEmulatorTypePredictor.h"
+#include "RiscvEmulatorTypeProfile.h"
 #include "RiscvEmulatorTypeRegister.h"
+#include "RiscvEmulatorTypeTrace.h"
+
+#if (RVE_E_ASYNC == 1)
+/**
+ * I/O an instance is waiting for.
+ */
+typedef struct {
+    /**
+     * One of PENDING_*.
+     */
+    uint8_t kind;
+    uint8_t length;
+    uint32_t address;
+
+    /**
+     * Value stored, or value loaded once completed.
+     */
+    uint32_t value;
+} RiscvEmulatorPending_t;
+#endif
 
 /**
  * Riscv emulator state flags.
@@ -47,13 +73,209 @@ typedef struct
     RiscvInstruction_u instruction;
     RiscvRegister_u reg;
 
+#if (RVE_E_OPS == 1)
+    /**
+     * Operations of this instance.
+     */
+    const struct RiscvEmulatorOps_s *ops;
+
+    /**
+     * Free for the operations, for example to find the memory of this instance.
+     */
+    void *context;
+#endif
+
+#if (RVE_E_ASYNC == 1)
+    /**
+     * I/O this instance is waiting for, see RiscvEmulatorResume().
+     */
+    RiscvEmulatorPending_t pending;
+#endif
+
+#if (RVE_E_RUN == 1)
+    /**
+     * Why RiscvEmulatorRun() stopped, one of EXIT_REASON_*.
+     */
+    uint8_t exitreason;
+
+    /**
+     * Instructions left in the current chunk of RiscvEmulatorRun().
+     */
+    uint32_t budget;
+
+    /**
+     * Length of the current chunk of RiscvEmulatorRun().
+     */
+    uint32_t chunk;
+
+    /**
+     * Instructions retired by RiscvEmulatorRun() before the current chunk.
+     */
+    uint64_t retired;
+#endif
+
 #if (RVE_E_HOOK == 1)
+    /**
+     * HOOK_MASK_* of the hooks passed to RiscvEmulatorHook(), can be changed between calls of RiscvEmulatorRun().
+     */
+    uint8_t hookmask;
+
     uint8_t hookexists;
 #endif
 
 #if (RVE_E_ZICSR == 1)
     RiscvCSR_t csr;
 #endif
+
+#if (RVE_E_ZICNTR == 1)
+    /**
+     * mcycle and minstret minus the number of instructions retired.
+     */
+    uint64_t mcycleoffset;
+    uint64_t minstretoffset;
+
+    /**
+     * Counter CSR being accessed, see RiscvEmulatorZicntrRead().
+     */
+    uint32_t counter;
+#endif
+
+#if (RVE_E_ZIHPM == 1)
+    /**
+     * Number of times each EVENT_* happened.
+     */
+    uint64_t eventcount[EVENT_COUNT];
+
+    /**
+     * Event counted by mhpmcounter3..31, and their value minus that count.
+     */
+    uint8_t mhpmevent[29];
+    uint64_t mhpmoffset[29];
+#endif
+
+#if (RVE_E_HISTOGRAM == 1)
+    /**
+     * Number of times each HOOK_INSTRUCTION_* was executed.
+     */
+    uint64_t histogram[HOOK_INSTRUCTION_COUNT];
+#endif
+
+#if (RVE_E_INTERRUPT == 1)
+    /**
+     * Set when mip, mie or mstatus changed, RiscvEmulatorRun() then looks for an interrupt to take.
+     */
+    uint8_t attention;
+
+    /**
+     * Set by WFI until an interrupt is pending.
+     */
+    uint8_t waiting;
+#endif
+
+#if (RVE_E_IDLE == 1)
+    /**
+     * Backward jump or branch of the loop being watched.
+     */
+    uint32_t idlebranch;
+    uint8_t idlecount;
+
+    /**
+     * Set by stores, CSR writes and calls into the implementation since registers were saved.
+     */
+    uint8_t idlesideeffect;
+
+    /**
+     * Registers when the loop was last looked at.
+     */
+    RiscvRegister_u idlereg;
+#endif
+
+#if (RVE_E_TRACE == 1)
+    /**
+     * Ring buffer receiving a record of every executed instruction, or 0.
+     */
+    RiscvEmulatorTrace_t *trace;
+
+    /**
+     * Record of the instruction being executed.
+     */
+    RiscvEmulatorTraceRecord_t tracerecord;
+#endif
+
+#if (RVE_E_PROFILE == 1)
+    /**
+     * Call tree sampled between chunks, or 0.
+     */
+    RiscvEmulatorProfile_t *profile;
+#endif
+
+#if (RVE_E_HEATMAP == 1)
+    /**
+     * Data memory accesses counted per cache line, or 0.
+     */
+    RiscvEmulatorHeatmap_t *heatmap;
+#endif
+
+#if (RVE_E_CACHE == 1)
+    /**
+     * Simulated caches fed by instruction fetches and data accesses, or 0.
+     */
+    RiscvEmulatorCache_t *icache;
+    RiscvEmulatorCache_t *dcache;
+#endif
+
+#if (RVE_E_PREDICTOR == 1)
+    /**
+     * Simulated branch predictor fed by branches and jumps, or 0.
+     */
+    RiscvEmulatorPredictor_t *predictor;
+#endif
+
+#if (RVE_E_CLINT == 1)
+    /**
+     * Machine timer compare register.
+     */
+    uint64_t mtimecmp;
+
+    /**
+     * mtime minus the number of instructions retired.
+     */
+    uint64_t mtimeoffset;
+
+    /**
+     * Machine software interrupt register, copied to MSIP in mip between chunks of RiscvEmulatorRun().
+     */
+    uint8_t msip;
+
+#if (RVE_E_SMP == 1)
+    /**
+     * mtime at the start of the current chunk, read by the other harts.
+     */
+    uint64_t mtime;
+#endif
+#endif
+
+#if (RVE_E_A == 1)
+    /**
+     * Reservation set registered by LR.W.
+     */
+    uint32_t reservationaddress;
+    uint8_t reservationvalid;
+
+#if (RVE_E_SMP == 1)
+    /**
+     * Value loaded by LR.W, SC.W fails when memory no longer holds it.
+     */
+    uint32_t reservationvalue;
+#endif
+#endif
+
+#if (RVE_E_SMP == 1)
+    /**
+     * Harts this one belongs to, set by RiscvEmulatorSmpInit(), or 0.
+     */
+    struct RiscvEmulatorSmp_s *smp;
+#endif
 } RiscvEmulatorState_t;
 
 #endif
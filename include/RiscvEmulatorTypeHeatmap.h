@@ -0,0 +1,38 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTypeHeatmap_H_
+#define RiscvEmulatorTypeHeatmap_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_HEATMAP == 1)
+
+#include <stdint.h>
+
+/**
+ * Data memory accesses per cache line, counted from the origin.
+ */
+typedef struct {
+    /**
+     * Address of the first cache line counted.
+     */
+    uint32_t origin;
+
+    /**
+     * Accesses before the origin or after the last cache line counted.
+     */
+    uint64_t outsideread;
+    uint64_t outsidewrite;
+
+    uint64_t read[RVE_HEATMAP_LINES];
+    uint64_t write[RVE_HEATMAP_LINES];
+} RiscvEmulatorHeatmap_t;
+
+#endif
+
+#endif
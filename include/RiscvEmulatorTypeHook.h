@@ -12,25 +12,30 @@
 
 /**
  * Generic hook function context.
+ *
+ * Members are ordered by size to keep it small.
  */
 typedef struct {
+    // HOOK_*
     uint8_t hook;
-    const char *instruction;
+    // HOOK_INSTRUCTION_*
+    uint8_t instruction;
     uint8_t rs1num;
-    const void *rs1;
     uint8_t rs2num;
-    const void *rs2;
     uint8_t rdnum;
-    const void *rd;
-    uint16_t csrnum;
-    const void *csr;
-    char *immname;
+    // HOOK_IMMEDIATE_*
+    uint8_t immname;
     uint8_t immlength;
     uint8_t immissigned;
+    uint8_t length;
+    uint16_t csrnum;
     uint32_t imm;
     uint32_t upperimmediate;
     uint32_t memorylocation;
-    uint8_t length;
+    const void *rs1;
+    const void *rs2;
+    const void *rd;
+    const void *csr;
 } RiscvEmulatorHookContext_t;
 
 #endif
@@ -0,0 +1,40 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTypeOps_H_
+#define RiscvEmulatorTypeOps_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_OPS == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulatorTypeEmulator.h"
+
+/**
+ * Operations of a single instance, replacing the functions of RiscvEmulatorImplementationSpecific.h.
+ *
+ * Every operation receives the state, so it can find its own memory through state->context.
+ */
+typedef struct RiscvEmulatorOps_s {
+    void (*load)(RiscvEmulatorState_t *state, uint32_t address, void *destination, uint8_t length);
+    void (*store)(RiscvEmulatorState_t *state, uint32_t address, const void *source, uint8_t length);
+    void (*illegalinstruction)(RiscvEmulatorState_t *state);
+#if (RVE_E_ZICSR == 1)
+    void (*unknowncsr)(RiscvEmulatorState_t *state);
+#endif
+    void (*handleecall)(RiscvEmulatorState_t *state);
+    void (*handleebreak)(RiscvEmulatorState_t *state);
+#if (RVE_E_SMP == 1)
+    void *(*hostaddress)(RiscvEmulatorState_t *state, uint32_t address);
+#endif
+} RiscvEmulatorOps_t;
+
+#endif
+
+#endif
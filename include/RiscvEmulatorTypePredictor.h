@@ -0,0 +1,96 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTypePredictor_H_
+#define RiscvEmulatorTypePredictor_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_PREDICTOR == 1)
+
+#include <stdint.h>
+
+/**
+ * Entry of the branch target buffer.
+ */
+typedef struct {
+    uint32_t programcounter;
+    uint32_t target;
+    uint8_t valid;
+} RiscvEmulatorPredictorTarget_t;
+
+/**
+ * Predictions of the branch or jump at a program counter, executed is 0 when the entry is free.
+ */
+typedef struct {
+    uint32_t programcounter;
+    uint64_t executed;
+    uint64_t taken;
+    uint64_t mispredicted;
+} RiscvEmulatorPredictorProgramCounter_t;
+
+/**
+ * A simulated branch predictor, see RiscvEmulatorPredictorInit().
+ */
+typedef struct {
+    /**
+     * One of PREDICTOR_*.
+     */
+    uint8_t kind;
+
+    /**
+     * Outcome of the previous branches for PREDICTOR_GSHARE, the last one in the lowest bit.
+     */
+    uint32_t history;
+
+    uint32_t countercount;
+    uint32_t targetcount;
+    uint32_t returncount;
+
+    /**
+     * Return addresses on the stack, and the slot of the last one.
+     */
+    uint32_t returndepth;
+    uint32_t returntop;
+
+    /**
+     * Conditional branches, and the ones going the other way than predicted.
+     */
+    uint64_t branches;
+    uint64_t branchmisses;
+
+    /**
+     * Jumps through a register that are not a return, and the ones the branch target buffer had another target for.
+     */
+    uint64_t indirects;
+    uint64_t indirectmisses;
+
+    /**
+     * Returns, and the ones the return address stack had another address for.
+     */
+    uint64_t returns;
+    uint64_t returnmisses;
+
+    /**
+     * Taken branches and direct jumps not in the branch target buffer, only found when decoded.
+     */
+    uint64_t targetmisses;
+
+    /**
+     * Branches and jumps of program counters not in the table because it was full.
+     */
+    uint64_t overflow;
+
+    uint8_t counter[RVE_PREDICTOR_COUNTERS];
+    RiscvEmulatorPredictorTarget_t target[RVE_PREDICTOR_TARGETS];
+    uint32_t returnaddress[RVE_PREDICTOR_RETURNS];
+    RiscvEmulatorPredictorProgramCounter_t programcounter[RVE_PREDICTOR_PROGRAMCOUNTERS];
+} RiscvEmulatorPredictor_t;
+
+#endif
+
+#endif
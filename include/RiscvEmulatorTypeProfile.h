@@ -0,0 +1,123 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTypeProfile_H_
+#define RiscvEmulatorTypeProfile_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_PROFILE == 1)
+
+#include <stdint.h>
+
+/**
+ * A function of the guest, see RiscvEmulatorProfileElf().
+ */
+typedef struct {
+    uint32_t address;
+
+    /**
+     * Size in bytes, 0 when unknown.
+     */
+    uint32_t size;
+
+    /**
+     * Points into the ELF file, which must be kept while profiling.
+     */
+    const char *name;
+} RiscvEmulatorProfileSymbol_t;
+
+/**
+ * A function with the calls leading to it.
+ */
+typedef struct {
+    /**
+     * Number of samples taken while executing this function, not counting the functions it called.
+     */
+    uint64_t count;
+
+    /**
+     * Number of instructions executed in this function, not counting the functions it called.
+     */
+    uint64_t instructions;
+
+    /**
+     * Number of calls from the parent, the weight of the edge in the call graph.
+     */
+    uint64_t calls;
+
+    /**
+     * Address the function was called at.
+     */
+    uint32_t address;
+
+    /**
+     * The caller, and a list of the functions called linked by their sibling.
+     */
+    uint32_t parent;
+    uint32_t child;
+    uint32_t sibling;
+} RiscvEmulatorProfileNode_t;
+
+/**
+ * Call tree following the guest with JAL and JALR, sampled by RiscvEmulatorRun().
+ */
+typedef struct {
+    /**
+     * Number of instructions between samples.
+     */
+    uint32_t interval;
+    uint32_t countdown;
+
+    /**
+     * Only take a sample after RiscvEmulatorProfileTimer() was called, interval then is the delay to notice it.
+     */
+    uint8_t timer;
+    uint8_t pending;
+
+    /**
+     * Node of the function being executed.
+     */
+    uint32_t current;
+
+    /**
+     * Instructions of the current chunk already counted in a node.
+     */
+    uint32_t mark;
+
+    /**
+     * Number of calls not in the call tree because it was full.
+     */
+    uint32_t overflow;
+
+    /**
+     * Number of calls not returned from yet, and the most seen.
+     */
+    uint32_t depth;
+    uint32_t deepest;
+
+    /**
+     * Lowest sp seen at a call, and the node called then.
+     */
+    uint32_t stackpointer;
+    uint32_t stacknode;
+
+    uint64_t samples;
+
+    /**
+     * Function symbols sorted by address.
+     */
+    const RiscvEmulatorProfileSymbol_t *symbol;
+    uint32_t symbolcount;
+
+    uint32_t nodecount;
+    RiscvEmulatorProfileNode_t node[RVE_PROFILE_NODES];
+} RiscvEmulatorProfile_t;
+
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTypeSmp_H_
+#define RiscvEmulatorTypeSmp_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_SMP == 1)
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "RiscvEmulatorTypeEmulator.h"
+
+/**
+ * Lock guarding atomic memory operations on a group of cache lines.
+ *
+ * Padded to its own host cache line so harts contending on different guest lines do not share one.
+ */
+typedef struct __attribute__((aligned(64))) {
+    uint8_t flag;
+} RiscvEmulatorAtomicLock_t;
+
+/**
+ * Harts sharing memory.
+ */
+typedef struct RiscvEmulatorSmp_s {
+    RiscvEmulatorState_t hart[RVE_SMP_HARTS];
+    pthread_t thread[RVE_SMP_HARTS];
+    uint8_t hartcount;
+
+    /**
+     * Instructions a hart executes before the scheduler looks at it again.
+     */
+    uint32_t quantum;
+
+    /**
+     * Set when harts only run in parallel between quantum barriers.
+     */
+    uint8_t synchronized;
+    pthread_barrier_t barrier;
+
+    /**
+     * Set to 1 when all synchronized threads are started, or 2 when starting failed.
+     */
+    uint8_t ready;
+
+    /**
+     * Decision of the last thread at a quantum barrier to stop, so all threads stop at the same barrier.
+     */
+    uint8_t halted;
+
+    /**
+     * Hands out a hart to each starting thread.
+     */
+    uint8_t started;
+
+    /**
+     * Number of host threads created by RiscvEmulatorSmpStart(), joined by RiscvEmulatorSmpJoin().
+     */
+    uint8_t threadcount;
+
+    /**
+     * Set to request all threads to stop.
+     */
+    uint8_t stop;
+} RiscvEmulatorSmp_t;
+
+#endif
+
+#endif
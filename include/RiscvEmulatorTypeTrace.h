@@ -0,0 +1,95 @@
+/*
+ *
+ * Copyright 2023-2025 Marc Ketel
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ */
+
+#ifndef RiscvEmulatorTypeTrace_H_
+#define RiscvEmulatorTypeTrace_H_
+
+#include "RiscvEmulatorConfig.h"
+
+#if (RVE_E_TRACE == 1)
+
+#include <stdint.h>
+
+#include "RiscvEmulatorDefineTrace.h"
+
+/**
+ * An executed instruction.
+ */
+typedef struct {
+    uint32_t programcounter;
+
+    /**
+     * The instruction, upper 16 bits are 0 for a compressed instruction.
+     */
+    uint32_t instruction;
+
+    /**
+     * Value of register rdnum after the instruction, rdnum is 0 when no register is written.
+     */
+    uint32_t rdvalue;
+
+    /**
+     * Last data memory access of the instruction, the value loaded or stored.
+     */
+    uint32_t memorylocation;
+    uint32_t memoryvalue;
+
+    uint8_t rdnum;
+
+    /**
+     * One of TRACE_MEMORY_*.
+     */
+    uint8_t memoryaccess;
+    uint8_t memorylength;
+    uint8_t reserved;
+} RiscvEmulatorTraceRecord_t;
+
+/**
+ * Ring buffer of trace records with a single producer, the instance, and a single consumer, any host thread.
+ *
+ * head is only written by the instance and tail only by the consumer, each in its own cache line.
+ */
+typedef struct {
+    RiscvEmulatorTraceRecord_t record[RVE_TRACE_LENGTH];
+
+    /**
+     * Number of records written.
+     */
+    uint32_t head __attribute__((aligned(64)));
+
+    /**
+     * Number of records written while the ring buffer was full.
+     */
+    uint32_t dropped;
+
+    /**
+     * Number of records read.
+     */
+    uint32_t tail __attribute__((aligned(64)));
+} RiscvEmulatorTrace_t;
+
+/**
+ * What the encoder and the decoder of a trace know about the previous records, identical on both sides.
+ */
+typedef struct {
+    /**
+     * Number of records encoded or decoded.
+     */
+    uint32_t count;
+
+    /**
+     * Program counter of the instruction following the previous record.
+     */
+    uint32_t programcounter;
+    uint32_t memorylocation;
+    uint32_t reg[32];
+    uint32_t dictionary[TRACE_CODEC_DICTIONARY_LENGTH];
+} RiscvEmulatorTraceCodec_t;
+
+#endif
+
+#endif